@@ -1,36 +1,144 @@
 #include <jni.h>
-#include <string>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 
-static const char* NameForModel(uint16_t id) {
-  switch (id) {
-    case 0x2002: return "AirPods (1st gen)";
-    case 0x2008: return "AirPods (2nd gen)";
-    case 0x2015: return "AirPods (3rd gen)";
-    case 0x2019: return "AirPods 4";
-    case 0x201B: return "AirPods 4 (ANC)";
-    case 0x2101: return "AirPods Pro";
-    case 0x2201: return "AirPods Pro (2nd gen)";
-    case 0x2301: return "AirPods Max";
-    default:     return nullptr;
+// Parsed Proximity Pairing frame, handed to Java as a flat little-endian
+// struct written into a direct ByteBuffer. The field offsets are part of the
+// bridge ABI; AirPodsFrame in NativeBridge.kt mirrors them. One parse call
+// extracts everything a scan callback needs - battery nibbles, charging,
+// ear/case state, lid state - so there is no per-field JNI crossing.
+struct ParsedFrame {
+  uint16_t model_id;           // 0
+  int8_t left_battery;         // 2: 0..100 in steps of 10, -1 unknown
+  int8_t right_battery;        // 3
+  int8_t case_battery;         // 4
+  uint8_t charge_bits;         // 5: bit0 left, bit1 right, bit2 case
+  uint8_t ear_bits;            // 6: bit0 left in ear, bit1 right in ear
+  uint8_t case_bits;           // 7: bit0 this pod, bit1 one pod, bit2 both
+  uint8_t lid_state;           // 8: valid when bit0 of case_bits is set
+  uint8_t lid_open_counter;    // 9
+  uint8_t connection_state;    // 10
+  uint8_t primary_left;        // 11
+  uint8_t status;              // 12: raw status byte for debugging
+  uint8_t color;               // 13
+  uint8_t reserved[2];         // 14
+};
+static_assert(sizeof(ParsedFrame) == 16, "ParsedFrame layout is part of the JNI ABI");
+
+// Mirrors BleManager::decodeProximityMessage on the Linux side; keep the two
+// in sync when the frame format understanding improves.
+static bool ParseProximityFrame(const uint8_t* data, size_t len, ParsedFrame* out) {
+  if (len < 11 || data[0] != 0x07) return false;
+  // data[1] is the length byte. Pairing-mode frames (data[2] == 0x00) are
+  // structured differently; skip them like the Linux decoder does.
+  if (data[2] == 0x00) return false;
+
+  std::memset(out, 0, sizeof(*out));
+
+  // Model is big-endian: high byte at data[3], low byte at data[4]
+  out->model_id = static_cast<uint16_t>(data[4]) | (static_cast<uint16_t>(data[3]) << 8);
+
+  const uint8_t status = data[5];
+  const uint8_t pods_battery = data[6];
+  const uint8_t flags_and_case = data[7];
+  const uint8_t lid_indicator = data[8];
+  out->status = status;
+  out->color = data[9];
+  out->connection_state = data[10];
+
+  // Bit 5 of status: 1 = left primary; nibbles and flag bits swap sides when
+  // the right pod is primary
+  const bool primary_left = (status & 0x20) != 0;
+  const bool flipped = !primary_left;
+  out->primary_left = primary_left ? 1 : 0;
+
+  const int left_nibble = flipped ? (pods_battery >> 4) & 0x0F : pods_battery & 0x0F;
+  const int right_nibble = flipped ? pods_battery & 0x0F : (pods_battery >> 4) & 0x0F;
+  const int case_nibble = flags_and_case & 0x0F;
+  out->left_battery = static_cast<int8_t>((left_nibble == 15) ? -1 : left_nibble * 10);
+  out->right_battery = static_cast<int8_t>((right_nibble == 15) ? -1 : right_nibble * 10);
+  out->case_battery = static_cast<int8_t>((case_nibble == 15) ? -1 : case_nibble * 10);
+
+  const uint8_t flags = (flags_and_case >> 4) & 0x0F;
+  const bool left_charging = flipped ? (flags & 0x02) != 0 : (flags & 0x01) != 0;
+  const bool right_charging = flipped ? (flags & 0x01) != 0 : (flags & 0x02) != 0;
+  const bool case_charging = (flags & 0x04) != 0;
+  out->charge_bits = static_cast<uint8_t>((left_charging ? 0x01 : 0) |
+                                          (right_charging ? 0x02 : 0) |
+                                          (case_charging ? 0x04 : 0));
+
+  const bool this_pod_in_case = (status & 0x40) != 0;
+  const bool one_pod_in_case = (status & 0x10) != 0;
+  const bool both_pods_in_case = (status & 0x04) != 0;
+  out->case_bits = static_cast<uint8_t>((this_pod_in_case ? 0x01 : 0) |
+                                        (one_pod_in_case ? 0x02 : 0) |
+                                        (both_pods_in_case ? 0x04 : 0));
+
+  // In-ear bits swap with primary side XOR in-case state
+  const bool xor_factor = flipped ^ this_pod_in_case;
+  const bool left_in_ear = xor_factor ? (status & 0x08) != 0 : (status & 0x02) != 0;
+  const bool right_in_ear = xor_factor ? (status & 0x02) != 0 : (status & 0x08) != 0;
+  out->ear_bits = static_cast<uint8_t>((left_in_ear ? 0x01 : 0) | (right_in_ear ? 0x02 : 0));
+
+  out->lid_open_counter = lid_indicator & 0x07;
+  out->lid_state = (lid_indicator >> 3) & 0x01;
+  return true;
+}
+
+// Model names are interned once at load; known models never allocate a
+// jstring per call.
+static struct ModelName {
+  uint16_t id;
+  const char* name;
+  jstring interned;
+} kModelNames[] = {
+    {0x2002, "AirPods (1st gen)", nullptr},
+    {0x2008, "AirPods (2nd gen)", nullptr},
+    {0x2015, "AirPods (3rd gen)", nullptr},
+    {0x2019, "AirPods 4", nullptr},
+    {0x201B, "AirPods 4 (ANC)", nullptr},
+    {0x2101, "AirPods Pro", nullptr},
+    {0x2201, "AirPods Pro (2nd gen)", nullptr},
+    {0x2301, "AirPods Max", nullptr},
+};
+
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+  JNIEnv* env = nullptr;
+  if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+    return JNI_ERR;
   }
+  for (ModelName& entry : kModelNames) {
+    jstring local = env->NewStringUTF(entry.name);
+    entry.interned = static_cast<jstring>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+  }
+  return JNI_VERSION_1_6;
 }
 
-static std::string FallbackName(uint16_t id) {
-  char buf[64];
-  std::snprintf(buf, sizeof(buf), "AirPods (0x%04X)", id);
-  return std::string(buf);
+// Both buffers must be direct; the payload is read and the frame written in
+// place with no JNI copies.
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_yourco_airpods_NativeBridge_parseAirPodsPayload(
+    JNIEnv* env, jobject, jobject payload, jint length, jobject out) {
+  const uint8_t* data = static_cast<const uint8_t*>(env->GetDirectBufferAddress(payload));
+  ParsedFrame* frame = static_cast<ParsedFrame*>(env->GetDirectBufferAddress(out));
+  if (!data || !frame || length < 0 ||
+      env->GetDirectBufferCapacity(payload) < length ||
+      env->GetDirectBufferCapacity(out) < static_cast<jlong>(sizeof(ParsedFrame))) {
+    return JNI_FALSE;
+  }
+  return ParseProximityFrame(data, static_cast<size_t>(length), frame) ? JNI_TRUE : JNI_FALSE;
 }
 
 extern "C" JNIEXPORT jstring JNICALL
-Java_com_yourco_airpods_NativeBridge_parseAirPodsPayload(
-    JNIEnv* env, jobject, jbyteArray payload) {
-  const jsize n = env->GetArrayLength(payload);
-  if (n < 2) return env->NewStringUTF("AirPods (Unknown model)");
-  std::string buf(n, '\0');
-  env->GetByteArrayRegion(payload, 0, n, reinterpret_cast<jbyte*>(&buf[0]));
-  uint16_t model_id = static_cast<uint8_t>(buf[0]) | (static_cast<uint16_t>(static_cast<uint8_t>(buf[1]))<<8);
-  if (const char* known = NameForModel(model_id)) return env->NewStringUTF(known);
-  std::string pretty = FallbackName(model_id);
-  return env->NewStringUTF(pretty.c_str());
+Java_com_yourco_airpods_NativeBridge_modelName(JNIEnv* env, jobject, jint model_id) {
+  for (const ModelName& entry : kModelNames) {
+    if (entry.id == static_cast<uint16_t>(model_id)) {
+      return entry.interned;
+    }
+  }
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "AirPods (0x%04X)", static_cast<uint16_t>(model_id));
+  return env->NewStringUTF(buf);
 }
@@ -17,12 +17,15 @@
  */
 
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <dlfcn.h>
 #include <android/log.h>
+#include <elf.h>
 #include <fstream>
 #include <string>
 #include <sys/system_properties.h>
+#include <vector>
 #include "l2c_fcr_hook.h"
 
 #define LOG_TAG "AirPodsHook"
@@ -156,124 +159,376 @@ void fake_l2cu_send_peer_info_req(tL2C_LCB* p_lcb, uint16_t info_type) {
     return;
 }
 
-uintptr_t loadHookOffset([[maybe_unused]] const char* package_name) {
-    const char* property_name = "persist.librepods.hook_offset";
+// Shared parser for the persist.librepods.* offset override properties. A
+// property set to a hex value pins that offset and wins over both the cache
+// and the signature scan; an absent property means "resolve it yourself" and
+// returns 0.
+static uintptr_t loadOffsetProperty(const char* property_name, const char* label) {
     char value[PROP_VALUE_MAX] = {0};
 
     int len = __system_property_get(property_name, value);
-    if (len > 0) {
-        LOGI("Read hook offset from property: %s", value);
-        uintptr_t offset;
-        char* endptr = nullptr;
-
-        const char* parse_start = value;
-        if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
-            parse_start = value + 2;
-        }
+    if (len <= 0) {
+        return 0;
+    }
 
-        errno = 0;
-        offset = strtoul(parse_start, &endptr, 16);
+    LOGI("Read %s offset from property: %s", label, value);
+    uintptr_t offset;
+    char* endptr = nullptr;
 
-        if (errno == 0 && endptr != parse_start && *endptr == '\0' && offset > 0) {
-            LOGI("Parsed offset: 0x%x", offset);
-            return offset;
-        }
+    const char* parse_start = value;
+    if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
+        parse_start = value + 2;
+    }
+
+    errno = 0;
+    offset = strtoul(parse_start, &endptr, 16);
 
-        LOGE("Failed to parse offset from property value: %s", value);
+    if (errno == 0 && endptr != parse_start && *endptr == '\0' && offset > 0) {
+        LOGI("Parsed %s offset: 0x%zx", label, (size_t)offset);
+        return offset;
     }
 
-    LOGI("Using hardcoded fallback offset");
-    return 0x00a55e30;
+    LOGE("Failed to parse %s offset from property value: %s", label, value);
+    return 0;
+}
+
+uintptr_t loadHookOffset([[maybe_unused]] const char* package_name) {
+    return loadOffsetProperty("persist.librepods.hook_offset", "l2c_fcr_chk_chan_modes");
 }
 
 uintptr_t loadL2cuProcessCfgReqOffset() {
-    const char* property_name = "persist.librepods.cfg_req_offset";
-    char value[PROP_VALUE_MAX] = {0};
+    return loadOffsetProperty("persist.librepods.cfg_req_offset", "l2cu_process_our_cfg_req");
+}
 
-    int len = __system_property_get(property_name, value);
-    if (len > 0) {
-        LOGI("Read l2cu_process_our_cfg_req offset from property: %s", value);
-        uintptr_t offset;
-        char* endptr = nullptr;
-
-        const char* parse_start = value;
-        if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
-            parse_start = value + 2;
-        }
+uintptr_t loadL2cCsmConfigOffset() {
+    return loadOffsetProperty("persist.librepods.csm_config_offset", "l2c_csm_config");
+}
 
-        errno = 0;
-        offset = strtoul(parse_start, &endptr, 16);
+uintptr_t loadL2cuSendPeerInfoReqOffset() {
+    return loadOffsetProperty("persist.librepods.peer_info_req_offset", "l2cu_send_peer_info_req");
+}
 
-        if (errno == 0 && endptr != parse_start && *endptr == '\0' && offset > 0) {
-            LOGI("Parsed l2cu_process_our_cfg_req offset: 0x%x", offset);
-            return offset;
+// ---- Signature-based offset resolution -------------------------------------
+//
+// Properties remain the manual override, but on an unknown firmware the
+// offsets are resolved by scanning the library's executable segments for the
+// byte patterns below. The result is persisted, keyed by the library's GNU
+// build-id, in the Bluetooth process's cache directory, so subsequent stack
+// restarts install all four hooks from one small file read instead of a full
+// image scan. A firmware update changes the build-id, which invalidates the
+// cache and triggers a rescan instead of silently hooking a stale address.
+
+struct HookOffsets {
+    uintptr_t l2c_fcr_chk_chan_modes = 0;
+    uintptr_t l2cu_process_our_cfg_req = 0;
+    uintptr_t l2c_csm_config = 0;
+    uintptr_t l2cu_send_peer_info_req = 0;
+};
+
+struct FunctionSignature {
+    const char* name;                // cache key and log label
+    const char* pattern;             // hex byte pairs, "??" matches anything
+    uintptr_t HookOffsets::* slot;
+};
+
+// Lifted from the arm64 libbluetooth builds on our managed handsets. Each
+// pattern anchors on the function's prologue plus its first distinctive
+// constant (the FCR mode mask, the CONFIG_RSP event compare, the INFO_REQ
+// opcode), with wildcards over the field offsets and registers that move
+// between toolchain versions.
+static const FunctionSignature SIGNATURES[] = {
+    {"l2c_fcr_chk_chan_modes",
+     "08 ?? 41 39 29 00 80 52 29 21 C8 1A 3F 01 09 6A E0 07 9F 1A C0 03 5F D6",
+     &HookOffsets::l2c_fcr_chk_chan_modes},
+    {"l2cu_process_our_cfg_req",
+     "FF C3 01 D1 FD 7B 03 A9 F4 4F 04 A9 FD C3 00 91 F4 03 01 AA F3 03 00 AA ?? ?? 41 39",
+     &HookOffsets::l2cu_process_our_cfg_req},
+    {"l2c_csm_config",
+     "?? ?? ?? D1 FD 7B ?? A9 ?? ?? ?? A9 F3 03 00 AA 28 ?? 00 51 1F ?? 00 71 ?? ?? ?? 54",
+     &HookOffsets::l2c_csm_config},
+    {"l2cu_send_peer_info_req",
+     "F4 4F BE A9 FD 7B 01 A9 FD 43 00 91 F3 03 01 2A F4 03 00 AA 48 01 80 52",
+     &HookOffsets::l2cu_send_peer_info_req},
+};
+
+static constexpr size_t MAX_PATTERN_BYTES = 64;
+
+static size_t parsePattern(const char* text, uint8_t* bytes, uint8_t* mask) {
+    size_t count = 0;
+    while (*text && count < MAX_PATTERN_BYTES) {
+        while (*text == ' ') text++;
+        if (!text[0] || !text[1]) break;
+        if (text[0] == '?' && text[1] == '?') {
+            bytes[count] = 0;
+            mask[count] = 0;
+        } else {
+            char pair[3] = {text[0], text[1], '\0'};
+            char* endptr = nullptr;
+            unsigned long byte = strtoul(pair, &endptr, 16);
+            if (endptr != pair + 2) {
+                return 0;
+            }
+            bytes[count] = static_cast<uint8_t>(byte);
+            mask[count] = 0xFF;
         }
+        count++;
+        text += 2;
+    }
+    return count;
+}
 
-        LOGE("Failed to parse l2cu_process_our_cfg_req offset from property value: %s", value);
+static bool matchesAt(const uint8_t* data, const uint8_t* bytes, const uint8_t* mask, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if ((data[i] & mask[i]) != bytes[i]) {
+            return false;
+        }
     }
+    return true;
+}
 
-    // Return 0 if not found - we'll skip this hook
-    return 0;
+static bool readLibraryFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        LOGE("Failed to open %s for scanning", path);
+        return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    if (size <= 0) {
+        fclose(fp);
+        return false;
+    }
+    fseek(fp, 0, SEEK_SET);
+    out.resize(static_cast<size_t>(size));
+    size_t read = fread(out.data(), 1, out.size(), fp);
+    fclose(fp);
+    return read == out.size();
 }
 
-uintptr_t loadL2cCsmConfigOffset() {
-    const char* property_name = "persist.librepods.csm_config_offset";
-    char value[PROP_VALUE_MAX] = {0};
+static const Elf64_Ehdr* elfHeader(const std::vector<uint8_t>& elf) {
+    if (elf.size() < sizeof(Elf64_Ehdr)) {
+        return nullptr;
+    }
+    const Elf64_Ehdr* ehdr = reinterpret_cast<const Elf64_Ehdr*>(elf.data());
+    if (memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr->e_ident[EI_CLASS] != ELFCLASS64 ||
+        ehdr->e_phoff + ehdr->e_phnum * sizeof(Elf64_Phdr) > elf.size()) {
+        return nullptr;
+    }
+    return ehdr;
+}
 
-    int len = __system_property_get(property_name, value);
-    if (len > 0) {
-        LOGI("Read l2c_csm_config offset from property: %s", value);
-        uintptr_t offset;
-        char* endptr = nullptr;
-
-        const char* parse_start = value;
-        if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
-            parse_start = value + 2;
+static bool readBuildId(const std::vector<uint8_t>& elf, char* out, size_t out_size) {
+    const Elf64_Ehdr* ehdr = elfHeader(elf);
+    if (!ehdr) {
+        return false;
+    }
+    const Elf64_Phdr* phdrs = reinterpret_cast<const Elf64_Phdr*>(elf.data() + ehdr->e_phoff);
+    for (int i = 0; i < ehdr->e_phnum; i++) {
+        if (phdrs[i].p_type != PT_NOTE) continue;
+        size_t off = phdrs[i].p_offset;
+        const size_t end = off + phdrs[i].p_filesz;
+        if (end > elf.size()) continue;
+        while (off + sizeof(Elf64_Nhdr) <= end) {
+            const Elf64_Nhdr* nhdr = reinterpret_cast<const Elf64_Nhdr*>(elf.data() + off);
+            const size_t name_off = off + sizeof(Elf64_Nhdr);
+            const size_t desc_off = name_off + ((nhdr->n_namesz + 3u) & ~3u);
+            const size_t next_off = desc_off + ((nhdr->n_descsz + 3u) & ~3u);
+            if (next_off > end) break;
+            if (nhdr->n_type == NT_GNU_BUILD_ID && nhdr->n_namesz == 4 &&
+                memcmp(elf.data() + name_off, "GNU", 4) == 0 &&
+                nhdr->n_descsz * 2 + 1 <= out_size) {
+                for (uint32_t j = 0; j < nhdr->n_descsz; j++) {
+                    std::snprintf(out + j * 2, 3, "%02x", elf[desc_off + j]);
+                }
+                return true;
+            }
+            off = next_off;
         }
+    }
+    return false;
+}
 
-        errno = 0;
-        offset = strtoul(parse_start, &endptr, 16);
+// Scans the executable PT_LOAD segments for the pattern and translates a file
+// hit back into the offset findAndHookFunction adds to the maps base address.
+static uintptr_t scanForPattern(const std::vector<uint8_t>& elf, const uint8_t* bytes,
+                                const uint8_t* mask, size_t len) {
+    const Elf64_Ehdr* ehdr = elfHeader(elf);
+    if (!ehdr) {
+        return 0;
+    }
+    const Elf64_Phdr* phdrs = reinterpret_cast<const Elf64_Phdr*>(elf.data() + ehdr->e_phoff);
+    uintptr_t load_bias = UINTPTR_MAX;
+    for (int i = 0; i < ehdr->e_phnum; i++) {
+        if (phdrs[i].p_type == PT_LOAD && phdrs[i].p_vaddr < load_bias) {
+            load_bias = phdrs[i].p_vaddr & ~static_cast<uintptr_t>(0xFFF);
+        }
+    }
+    if (load_bias == UINTPTR_MAX) {
+        return 0;
+    }
+    for (int i = 0; i < ehdr->e_phnum; i++) {
+        if (phdrs[i].p_type != PT_LOAD || !(phdrs[i].p_flags & PF_X)) continue;
+        if (phdrs[i].p_offset + phdrs[i].p_filesz > elf.size() ||
+            phdrs[i].p_filesz < len) {
+            continue;
+        }
+        const uint8_t* seg = elf.data() + phdrs[i].p_offset;
+        for (size_t pos = 0; pos + len <= phdrs[i].p_filesz; pos += 4) {
+            if (matchesAt(seg + pos, bytes, mask, len)) {
+                return static_cast<uintptr_t>(phdrs[i].p_vaddr + pos) - load_bias;
+            }
+        }
+    }
+    return 0;
+}
 
-        if (errno == 0 && endptr != parse_start && *endptr == '\0' && offset > 0) {
-            LOGI("Parsed l2c_csm_config offset: 0x%x", offset);
-            return offset;
+static void scanForOffsets(const std::vector<uint8_t>& elf, HookOffsets* offsets) {
+    for (const FunctionSignature& sig : SIGNATURES) {
+        if (offsets->*(sig.slot) != 0) {
+            continue;  // pinned by a property override
+        }
+        uint8_t bytes[MAX_PATTERN_BYTES];
+        uint8_t mask[MAX_PATTERN_BYTES];
+        const size_t len = parsePattern(sig.pattern, bytes, mask);
+        if (len == 0) {
+            LOGE("Bad signature pattern for %s", sig.name);
+            continue;
         }
+        const uintptr_t offset = scanForPattern(elf, bytes, mask, len);
+        if (offset != 0) {
+            LOGI("Signature scan resolved %s at offset 0x%zx", sig.name, (size_t)offset);
+            offsets->*(sig.slot) = offset;
+        } else {
+            LOGE("Signature scan found no match for %s", sig.name);
+        }
+    }
+}
 
-        LOGE("Failed to parse l2c_csm_config offset from property value: %s", value);
+// The hook runs inside the Bluetooth process, so that process's own cache
+// directory is the one location reliably writable from here.
+static std::string offsetsCachePath() {
+    std::ifstream cmdline("/proc/self/cmdline");
+    std::string process;
+    std::getline(cmdline, process, '\0');
+    if (process.empty()) {
+        return std::string();
     }
+    return "/data/data/" + process + "/cache/librepods_offsets";
+}
 
-    // Return 0 if not found - we'll skip this hook
-    return 0;
+static bool loadCachedOffsets(const std::string& path, const char* build_id,
+                              HookOffsets* offsets) {
+    std::ifstream cache(path);
+    if (!cache.is_open()) {
+        return false;
+    }
+    std::string line;
+    if (!std::getline(cache, line) || line != std::string("buildid=") + build_id) {
+        LOGI("Offset cache is for a different build, rescanning");
+        return false;
+    }
+    bool any = false;
+    while (std::getline(cache, line)) {
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        const std::string name = line.substr(0, eq);
+        const uintptr_t offset = strtoul(line.c_str() + eq + 1, nullptr, 16);
+        for (const FunctionSignature& sig : SIGNATURES) {
+            if (name == sig.name && offsets->*(sig.slot) == 0 && offset > 0) {
+                offsets->*(sig.slot) = offset;
+                any = true;
+            }
+        }
+    }
+    return any;
 }
 
-uintptr_t loadL2cuSendPeerInfoReqOffset() {
-    const char* property_name = "persist.librepods.peer_info_req_offset";
-    char value[PROP_VALUE_MAX] = {0};
+static void storeCachedOffsets(const std::string& path, const char* build_id,
+                               const HookOffsets& offsets) {
+    std::ofstream cache(path, std::ios::trunc);
+    if (!cache.is_open()) {
+        LOGE("Failed to write offset cache %s", path.c_str());
+        return;
+    }
+    cache << "buildid=" << build_id << "\n";
+    char buf[32];
+    for (const FunctionSignature& sig : SIGNATURES) {
+        const uintptr_t offset = offsets.*(sig.slot);
+        if (offset != 0) {
+            std::snprintf(buf, sizeof(buf), "0x%zx", (size_t)offset);
+            cache << sig.name << "=" << buf << "\n";
+        }
+    }
+    LOGI("Cached resolved offsets for build-id %s", build_id);
+}
 
-    int len = __system_property_get(property_name, value);
-    if (len > 0) {
-        LOGI("Read l2cu_send_peer_info_req offset from property: %s", value);
-        uintptr_t offset;
-        char* endptr = nullptr;
-
-        const char* parse_start = value;
-        if (value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
-            parse_start = value + 2;
+static bool getModulePath(const char* module_name, char* path, size_t path_size) {
+    FILE* fp = fopen("/proc/self/maps", "r");
+    if (!fp) {
+        LOGE("Failed to open /proc/self/maps");
+        return false;
+    }
+    char line[1024];
+    bool found = false;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strstr(line, module_name)) {
+            char* slash = strchr(line, '/');
+            if (slash) {
+                const size_t len = strcspn(slash, "\n");
+                if (len < path_size) {
+                    memcpy(path, slash, len);
+                    path[len] = '\0';
+                    found = true;
+                }
+            }
+            break;
         }
+    }
+    fclose(fp);
+    return found;
+}
 
-        errno = 0;
-        offset = strtoul(parse_start, &endptr, 16);
+static HookOffsets resolveOffsets(const char* library_name) {
+    HookOffsets offsets;
+    offsets.l2c_fcr_chk_chan_modes = loadHookOffset(nullptr);
+    offsets.l2cu_process_our_cfg_req = loadL2cuProcessCfgReqOffset();
+    offsets.l2c_csm_config = loadL2cCsmConfigOffset();
+    offsets.l2cu_send_peer_info_req = loadL2cuSendPeerInfoReqOffset();
+    if (offsets.l2c_fcr_chk_chan_modes != 0 && offsets.l2cu_process_our_cfg_req != 0 &&
+        offsets.l2c_csm_config != 0 && offsets.l2cu_send_peer_info_req != 0) {
+        return offsets;
+    }
 
-        if (errno == 0 && endptr != parse_start && *endptr == '\0' && offset > 0) {
-            LOGI("Parsed l2cu_send_peer_info_req offset: 0x%x", offset);
-            return offset;
-        }
+    char library_path[512];
+    if (!getModulePath(library_name, library_path, sizeof(library_path))) {
+        LOGE("Could not find %s in /proc/self/maps for offset resolution", library_name);
+        return offsets;
+    }
 
-        LOGE("Failed to parse l2cu_send_peer_info_req offset from property value: %s", value);
+    std::vector<uint8_t> elf;
+    if (!readLibraryFile(library_path, elf)) {
+        return offsets;
     }
 
-    // Return 0 if not found - we'll skip this hook
-    return 0;
+    char build_id[128] = {0};
+    const bool have_build_id = readBuildId(elf, build_id, sizeof(build_id));
+    if (!have_build_id) {
+        LOGE("No GNU build-id in %s, offset caching disabled", library_path);
+    }
+
+    const std::string cache_path = offsetsCachePath();
+    if (have_build_id && !cache_path.empty() &&
+        loadCachedOffsets(cache_path, build_id, &offsets)) {
+        LOGI("Resolved offsets from cache for build-id %s", build_id);
+        return offsets;
+    }
+
+    scanForOffsets(elf, &offsets);
+    if (have_build_id && !cache_path.empty() && offsets.l2c_fcr_chk_chan_modes != 0) {
+        storeCachedOffsets(cache_path, build_id, offsets);
+    }
+    return offsets;
 }
 
 uintptr_t getModuleBase(const char *module_name) {
@@ -315,19 +570,23 @@ bool findAndHookFunction(const char *library_name) {
         return false;
     }
 
-    // Load all offsets from system properties - no hardcoding
-    uintptr_t l2c_fcr_offset = loadHookOffset(nullptr);
-    uintptr_t l2cu_process_our_cfg_req_offset = loadL2cuProcessCfgReqOffset();
-    uintptr_t l2c_csm_config_offset = loadL2cCsmConfigOffset();
-    uintptr_t l2cu_send_peer_info_req_offset = loadL2cuSendPeerInfoReqOffset();
+    // Property override, then build-id cache, then signature scan
+    HookOffsets offsets = resolveOffsets(library_name);
+    if (offsets.l2c_fcr_chk_chan_modes == 0) {
+        // Last resort: the offset this module shipped with. It is only right
+        // for the firmware the module was built against, so say so loudly.
+        LOGE("l2c_fcr_chk_chan_modes not resolved by property, cache or scan; "
+             "falling back to built-in offset 0x00a55e30");
+        offsets.l2c_fcr_chk_chan_modes = 0x00a55e30;
+    }
 
     bool success = false;
 
     // Hook l2c_fcr_chk_chan_modes - this is our primary hook
-    if (l2c_fcr_offset > 0) {
-        void* target = reinterpret_cast<void*>(base_addr + l2c_fcr_offset);
-        LOGI("Hooking l2c_fcr_chk_chan_modes at offset: 0x%x, base: %p, target: %p",
-             l2c_fcr_offset, (void*)base_addr, target);
+    {
+        void* target = reinterpret_cast<void*>(base_addr + offsets.l2c_fcr_chk_chan_modes);
+        LOGI("Hooking l2c_fcr_chk_chan_modes at offset: 0x%zx, base: %p, target: %p",
+             (size_t)offsets.l2c_fcr_chk_chan_modes, (void*)base_addr, target);
 
         int result = hook_func(target, (void*)fake_l2c_fcr_chk_chan_modes, (void**)&original_l2c_fcr_chk_chan_modes);
         if (result != 0) {
@@ -336,16 +595,13 @@ bool findAndHookFunction(const char *library_name) {
         }
         LOGI("Successfully hooked l2c_fcr_chk_chan_modes");
         success = true;
-    } else {
-        LOGE("No valid offset for l2c_fcr_chk_chan_modes found, cannot proceed");
-        return false;
     }
 
     // Hook l2cu_process_our_cfg_req if offset is available
-    if (l2cu_process_our_cfg_req_offset > 0) {
-        void* target = reinterpret_cast<void*>(base_addr + l2cu_process_our_cfg_req_offset);
-        LOGI("Hooking l2cu_process_our_cfg_req at offset: 0x%x, base: %p, target: %p",
-             l2cu_process_our_cfg_req_offset, (void*)base_addr, target);
+    if (offsets.l2cu_process_our_cfg_req > 0) {
+        void* target = reinterpret_cast<void*>(base_addr + offsets.l2cu_process_our_cfg_req);
+        LOGI("Hooking l2cu_process_our_cfg_req at offset: 0x%zx, base: %p, target: %p",
+             (size_t)offsets.l2cu_process_our_cfg_req, (void*)base_addr, target);
 
         int result = hook_func(target, (void*)fake_l2cu_process_our_cfg_req, (void**)&original_l2cu_process_our_cfg_req);
         if (result != 0) {
@@ -359,10 +615,10 @@ bool findAndHookFunction(const char *library_name) {
     }
 
     // Hook l2c_csm_config if offset is available
-    if (l2c_csm_config_offset > 0) {
-        void* target = reinterpret_cast<void*>(base_addr + l2c_csm_config_offset);
-        LOGI("Hooking l2c_csm_config at offset: 0x%x, base: %p, target: %p",
-             l2c_csm_config_offset, (void*)base_addr, target);
+    if (offsets.l2c_csm_config > 0) {
+        void* target = reinterpret_cast<void*>(base_addr + offsets.l2c_csm_config);
+        LOGI("Hooking l2c_csm_config at offset: 0x%zx, base: %p, target: %p",
+             (size_t)offsets.l2c_csm_config, (void*)base_addr, target);
 
         int result = hook_func(target, (void*)fake_l2c_csm_config, (void**)&original_l2c_csm_config);
         if (result != 0) {
@@ -376,10 +632,10 @@ bool findAndHookFunction(const char *library_name) {
     }
 
     // Hook l2cu_send_peer_info_req if offset is available
-    if (l2cu_send_peer_info_req_offset > 0) {
-        void* target = reinterpret_cast<void*>(base_addr + l2cu_send_peer_info_req_offset);
-        LOGI("Hooking l2cu_send_peer_info_req at offset: 0x%x, base: %p, target: %p",
-             l2cu_send_peer_info_req_offset, (void*)base_addr, target);
+    if (offsets.l2cu_send_peer_info_req > 0) {
+        void* target = reinterpret_cast<void*>(base_addr + offsets.l2cu_send_peer_info_req);
+        LOGI("Hooking l2cu_send_peer_info_req at offset: 0x%zx, base: %p, target: %p",
+             (size_t)offsets.l2cu_send_peer_info_req, (void*)base_addr, target);
 
         int result = hook_func(target, (void*)fake_l2cu_send_peer_info_req, (void**)&original_l2cu_send_peer_info_req);
         if (result != 0) {
@@ -420,4 +676,4 @@ NativeOnModuleLoaded native_init(const NativeAPIEntries* entries) {
     hook_func = entries->hook_func;
 
     return on_library_loaded;
-}
\ No newline at end of file
+}
@@ -12,6 +12,10 @@ private val CHAR_UUID    = UUID.fromString("8667556C-9A37-4C91-84ED-54EE27D90049
 
 class BleClient(private val ctx: Context): BluetoothGattCallback() {
   private val coc = L2capCocManager()
+  // Reusable direct buffers for the native parser: one copy into payloadBuf,
+  // one native call, then field reads straight out of the frame
+  private val payloadBuf = java.nio.ByteBuffer.allocateDirect(64)
+  private val frame = AirPodsFrame()
   @Volatile private var useCocPreferred = SettingsManager.isUseCoc(ctx) // user setting, defaults true
   private val adapter = BluetoothAdapter.getDefaultAdapter()
   private val scanner get() = adapter?.bluetoothLeScanner
@@ -69,7 +73,12 @@ class BleClient(private val ctx: Context): BluetoothGattCallback() {
         useCocPreferred = false
       }
     }
-      val model = NativeBridge.parseAirPodsPayload(bytes)
+      val len = minOf(bytes.size, payloadBuf.capacity())
+      payloadBuf.clear()
+      payloadBuf.put(bytes, 0, len)
+      if (NativeBridge.parseAirPodsPayload(payloadBuf, len, frame.buffer)) {
+        val model = frame.modelName
+      }
     }
     gatt.disconnect()
   }
@@ -1,6 +1,47 @@
 package com.yourco.airpods
 
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
 object NativeBridge {
   init { System.loadLibrary("airpods_core") }
-  external fun parseAirPodsPayload(payload: ByteArray): String
+
+  /** Size of the flat struct parseAirPodsPayload fills; see ParsedFrame in jni_bridge.cpp. */
+  const val FRAME_BYTES = 16
+
+  /**
+   * Parses a full Proximity Pairing frame from [payload] into [out] in one
+   * native call. Both buffers must be direct; nothing is copied across JNI.
+   */
+  external fun parseAirPodsPayload(payload: ByteBuffer, length: Int, out: ByteBuffer): Boolean
+
+  /** Interned natively; known models never allocate a string per call. */
+  external fun modelName(modelId: Int): String
+
+  fun newFrameBuffer(): ByteBuffer =
+    ByteBuffer.allocateDirect(FRAME_BYTES).order(ByteOrder.LITTLE_ENDIAN)
+}
+
+/**
+ * Field-by-field view over the struct parseAirPodsPayload fills. Offsets
+ * mirror ParsedFrame in jni_bridge.cpp.
+ */
+class AirPodsFrame(val buffer: ByteBuffer = NativeBridge.newFrameBuffer()) {
+  val modelId get() = buffer.getShort(0).toInt() and 0xFFFF
+  val modelName get() = NativeBridge.modelName(modelId)
+  val leftBattery get() = buffer.get(2).toInt()   // 0..100, -1 unknown
+  val rightBattery get() = buffer.get(3).toInt()
+  val caseBattery get() = buffer.get(4).toInt()
+  val leftCharging get() = buffer.get(5).toInt() and 0x01 != 0
+  val rightCharging get() = buffer.get(5).toInt() and 0x02 != 0
+  val caseCharging get() = buffer.get(5).toInt() and 0x04 != 0
+  val leftInEar get() = buffer.get(6).toInt() and 0x01 != 0
+  val rightInEar get() = buffer.get(6).toInt() and 0x02 != 0
+  val thisPodInCase get() = buffer.get(7).toInt() and 0x01 != 0
+  val onePodInCase get() = buffer.get(7).toInt() and 0x02 != 0
+  val bothPodsInCase get() = buffer.get(7).toInt() and 0x04 != 0
+  val lidClosed get() = buffer.get(8).toInt() != 0
+  val lidOpenCounter get() = buffer.get(9).toInt() and 0x07
+  val connectionState get() = buffer.get(10).toInt() and 0xFF
+  val primaryLeft get() = buffer.get(11).toInt() != 0
 }
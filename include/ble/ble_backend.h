@@ -2,10 +2,57 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <functional>
 
 // Unified GATT read for both Windows & Linux backends.
 std::optional<std::vector<uint8_t>>
 ble_read_characteristic(const std::string& device_id,
                         const std::string& service_uuid,
                         const std::string& characteristic_uuid,
-                        std::string* error_out = nullptr);
\ No newline at end of file
+                        std::string* error_out = nullptr);
+
+// Outcome of one GATT read issued through BleBackend.
+struct BleReadResult {
+  std::string char_object_path;
+  std::optional<std::vector<uint8_t>> value;
+  std::string error;  // set when value is empty
+};
+
+using BleReadCallback = std::function<void(const BleReadResult&)>;
+
+// Connection-owning backend. Holds one pooled bus connection for the process
+// instead of reconnecting per read, keeps any number of ReadValue calls in
+// flight at once, and batch-reads a list of characteristics in a single
+// dispatch loop pass so N reads cost one round-trip latency, not N.
+class BleBackend {
+public:
+  static BleBackend& instance();
+
+  // Queues a ReadValue call; the callback fires from poll() or
+  // read_characteristics() on the calling thread. Returns false (with
+  // error_out set) if the call could not be sent.
+  bool read_characteristic_async(const std::string& char_object_path,
+                                 BleReadCallback callback,
+                                 std::string* error_out = nullptr);
+
+  // Pumps the connection once, waiting up to timeout_ms for replies.
+  // Returns the number of reads completed during this pass.
+  int poll(int timeout_ms);
+
+  // Issues every read up front, then drives one dispatch loop until all
+  // complete or timeout_ms elapses. Results keep the order of the input
+  // paths; unanswered reads come back with a timeout error.
+  std::vector<BleReadResult>
+  read_characteristics(const std::vector<std::string>& char_object_paths,
+                       int timeout_ms = 5000);
+
+  BleBackend(const BleBackend&) = delete;
+  BleBackend& operator=(const BleBackend&) = delete;
+
+private:
+  BleBackend();
+  ~BleBackend();
+
+  struct Impl;  // keeps bus library types out of this cross-platform header
+  Impl* impl_;
+};
@@ -1,21 +1,40 @@
+#pragma once
+
 #include <QByteArray>
+#include <array>
+#include <optional>
+
+#include "packethex.hpp"
 
 // Control Command Header
 namespace ControlCommand
 {
-    static const QByteArray HEADER = QByteArray::fromHex("040004000900");
+    inline constexpr auto HEADER_BYTES = PacketHex::fromHex("040004000900");
+    static const QByteArray HEADER = PacketHex::view(HEADER_BYTES);
+
+    // Assembles a control command table at compile time when the arguments
+    // are constants, and at runtime otherwise.
+    constexpr std::array<uint8_t, 11> commandBytes(uint8_t identifier, uint8_t data1 = 0x00, uint8_t data2 = 0x00,
+                                                   uint8_t data3 = 0x00, uint8_t data4 = 0x00)
+    {
+        std::array<uint8_t, 11> packet{};
+        for (size_t i = 0; i < HEADER_BYTES.size(); ++i)
+        {
+            packet[i] = HEADER_BYTES[i];
+        }
+        packet[6] = identifier;
+        packet[7] = data1;
+        packet[8] = data2;
+        packet[9] = data3;
+        packet[10] = data4;
+        return packet;
+    }
 
     // Helper function to create control command packets
     static QByteArray createCommand(quint8 identifier, quint8 data1 = 0x00, quint8 data2 = 0x00,
                                     quint8 data3 = 0x00, quint8 data4 = 0x00)
     {
-        QByteArray packet = HEADER;
-        packet.append(static_cast<char>(identifier));
-        packet.append(static_cast<char>(data1));
-        packet.append(static_cast<char>(data2));
-        packet.append(static_cast<char>(data3));
-        packet.append(static_cast<char>(data4));
-        return packet;
+        return PacketHex::copy(commandBytes(identifier, data1, data2, data3, data4));
     }
 
     inline std::optional<char> parseActive(const QByteArray &data)
@@ -31,8 +50,11 @@ template <quint8 CommandId>
 struct BasicControlCommand
 {
     static constexpr quint8 ID = CommandId;
-    static const QByteArray HEADER;
+    static constexpr auto HEADER_BYTES = PacketHex::append(ControlCommand::HEADER_BYTES, CommandId);
+    static constexpr auto ENABLED_BYTES = ControlCommand::commandBytes(CommandId, 0x01);
+    static constexpr auto DISABLED_BYTES = ControlCommand::commandBytes(CommandId, 0x02);
 
+    static const QByteArray HEADER;
     static const QByteArray ENABLED;
     static const QByteArray DISABLED;
 
@@ -63,10 +85,10 @@ struct BasicControlCommand
 };
 
 template <quint8 CommandId>
-const QByteArray BasicControlCommand<CommandId>::HEADER = ControlCommand::HEADER + static_cast<char>(CommandId);
+const QByteArray BasicControlCommand<CommandId>::HEADER = PacketHex::view(BasicControlCommand<CommandId>::HEADER_BYTES);
 
 template <quint8 CommandId>
-const QByteArray BasicControlCommand<CommandId>::ENABLED = create(0x01);
+const QByteArray BasicControlCommand<CommandId>::ENABLED = PacketHex::view(BasicControlCommand<CommandId>::ENABLED_BYTES);
 
 template <quint8 CommandId>
-const QByteArray BasicControlCommand<CommandId>::DISABLED = create(0x02);
\ No newline at end of file
+const QByteArray BasicControlCommand<CommandId>::DISABLED = PacketHex::view(BasicControlCommand<CommandId>::DISABLED_BYTES);
@@ -1,9 +1,12 @@
 #include "BluetoothMonitor.h"
 #include "logger.h"
+#include "metricsregistry.hpp"
 
 #include <QDebug>
 #include <QDBusObjectPath>
 #include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 
 BluetoothMonitor::BluetoothMonitor(QObject *parent)
     : QObject(parent), m_dbus(QDBusConnection::systemBus())
@@ -11,6 +14,7 @@ BluetoothMonitor::BluetoothMonitor(QObject *parent)
     // Register meta-types for D-Bus interaction
     qDBusRegisterMetaType<QDBusObjectPath>();
     qDBusRegisterMetaType<ManagedObjectList>();
+    qDBusRegisterMetaType<InterfaceList>();
 
     if (!m_dbus.isConnected())
     {
@@ -19,6 +23,7 @@ BluetoothMonitor::BluetoothMonitor(QObject *parent)
     }
 
     registerDBusService();
+    refreshDeviceCache();
     checkAlreadyConnectedDevices(); // Check for already connected devices on startup
 }
 
@@ -35,6 +40,93 @@ void BluetoothMonitor::registerDBusService()
     {
         LOG_WARN("Failed to connect to D-Bus PropertiesChanged signal");
     }
+
+    // Track device appearance/removal so the cache stays current without polling
+    if (!m_dbus.connect("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "InterfacesAdded",
+                        this, SLOT(onInterfacesAdded(QDBusObjectPath, InterfaceList))))
+    {
+        LOG_WARN("Failed to connect to D-Bus InterfacesAdded signal");
+    }
+    if (!m_dbus.connect("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "InterfacesRemoved",
+                        this, SLOT(onInterfacesRemoved(QDBusObjectPath, QStringList))))
+    {
+        LOG_WARN("Failed to connect to D-Bus InterfacesRemoved signal");
+    }
+}
+
+void BluetoothMonitor::refreshDeviceCache()
+{
+    // One async GetManagedObjects instead of three Get round trips per
+    // PropertiesChanged signal; the reply lands without blocking the GUI thread
+    QDBusMessage call = QDBusMessage::createMethodCall("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    MetricsRegistry::instance().add(MetricsRegistry::DBusCallsIssued);
+    QDBusPendingCall pending = m_dbus.asyncCall(call);
+    auto *watcher = new QDBusPendingCallWatcher(pending, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher)
+    {
+        watcher->deleteLater();
+        QDBusPendingReply<ManagedObjectList> reply = *watcher;
+        if (reply.isError())
+        {
+            MetricsRegistry::instance().add(MetricsRegistry::DBusCallsFailed);
+            LOG_WARN("Failed to populate device cache: " << reply.error().message());
+            return;
+        }
+
+        const ManagedObjectList managedObjects = reply.value();
+        for (auto it = managedObjects.constBegin(); it != managedObjects.constEnd(); ++it)
+        {
+            const QMap<QString, QVariantMap> &interfaces = it.value();
+            if (interfaces.contains("org.bluez.Device1"))
+            {
+                cacheDeviceProperties(it.key().path(), interfaces.value("org.bluez.Device1"));
+            }
+        }
+        LOG_DEBUG("Device cache populated with " << m_devices.size() << " devices");
+    });
+}
+
+void BluetoothMonitor::cacheDeviceProperties(const QString &devicePath, const QVariantMap &deviceProps)
+{
+    DeviceRecord &record = m_devices[devicePath];
+    if (deviceProps.contains("UUIDs"))
+    {
+        record.isAirPods = deviceProps["UUIDs"].toStringList().contains("74ec2172-0bad-4d01-8f77-997b2be0722a");
+    }
+    if (deviceProps.contains("Address"))
+    {
+        record.address = deviceProps["Address"].toString();
+    }
+    if (deviceProps.contains("Name"))
+    {
+        record.name = deviceProps["Name"].toString();
+    }
+}
+
+const BluetoothMonitor::DeviceRecord &BluetoothMonitor::lookupDevice(const QString &devicePath)
+{
+    auto it = m_devices.constFind(devicePath);
+    if (it != m_devices.constEnd())
+    {
+        return *it;
+    }
+
+    // Cache miss: a signal raced the initial GetManagedObjects reply. Resolve
+    // this path the old way once; every later signal hits the cache.
+    DeviceRecord record;
+    record.isAirPods = isAirPodsDevice(devicePath);
+    if (record.isAirPods)
+    {
+        QDBusInterface deviceInterface("org.bluez", devicePath, "org.freedesktop.DBus.Properties", m_dbus);
+        MetricsRegistry::instance().add(MetricsRegistry::DBusCallsIssued);
+        QDBusReply<QVariant> addrReply = deviceInterface.call("Get", "org.bluez.Device1", "Address");
+        if (addrReply.isValid())
+        {
+            record.address = addrReply.value().toString();
+        }
+        record.name = getDeviceName(devicePath);
+    }
+    return *m_devices.insert(devicePath, record);
 }
 
 bool BluetoothMonitor::isAirPodsDevice(const QString &devicePath)
@@ -42,9 +134,11 @@ bool BluetoothMonitor::isAirPodsDevice(const QString &devicePath)
     QDBusInterface deviceInterface("org.bluez", devicePath, "org.freedesktop.DBus.Properties", m_dbus);
 
     // Get UUIDs to check if it's an AirPods device
+    MetricsRegistry::instance().add(MetricsRegistry::DBusCallsIssued);
     QDBusReply<QVariant> uuidsReply = deviceInterface.call("Get", "org.bluez.Device1", "UUIDs");
     if (!uuidsReply.isValid())
     {
+        MetricsRegistry::instance().add(MetricsRegistry::DBusCallsFailed);
         return false;
     }
 
@@ -55,6 +149,7 @@ bool BluetoothMonitor::isAirPodsDevice(const QString &devicePath)
 QString BluetoothMonitor::getDeviceName(const QString &devicePath)
 {
     QDBusInterface deviceInterface("org.bluez", devicePath, "org.freedesktop.DBus.Properties", m_dbus);
+    MetricsRegistry::instance().add(MetricsRegistry::DBusCallsIssued);
     QDBusReply<QVariant> nameReply = deviceInterface.call("Get", "org.bluez.Device1", "Name");
     if (nameReply.isValid())
     {
@@ -66,10 +161,12 @@ QString BluetoothMonitor::getDeviceName(const QString &devicePath)
 bool BluetoothMonitor::checkAlreadyConnectedDevices()
 {
     QDBusInterface objectManager("org.bluez", "/", "org.freedesktop.DBus.ObjectManager", m_dbus);
+    MetricsRegistry::instance().add(MetricsRegistry::DBusCallsIssued);
     QDBusMessage reply = objectManager.call("GetManagedObjects");
 
     if (reply.type() == QDBusMessage::ErrorMessage)
     {
+        MetricsRegistry::instance().add(MetricsRegistry::DBusCallsFailed);
         LOG_WARN("Failed to get managed objects: " << reply.errorMessage());
         return false;
     }
@@ -90,6 +187,9 @@ bool BluetoothMonitor::checkAlreadyConnectedDevices()
         {
             const QVariantMap &deviceProps = interfaces.value("org.bluez.Device1");
 
+            // The reply carries everything the cache needs, so fill it here too
+            cacheDeviceProperties(objPath.path(), deviceProps);
+
             // Check if the device has the necessary properties
             if (!deviceProps.contains("UUIDs") || !deviceProps.contains("Connected") ||
                 !deviceProps.contains("Address") || !deviceProps.contains("Name"))
@@ -117,6 +217,79 @@ bool BluetoothMonitor::checkAlreadyConnectedDevices()
     return deviceFound;
 }
 
+QString BluetoothMonitor::devicePathForAddress(const QString &macAddress) const
+{
+    for (auto it = m_devices.constBegin(); it != m_devices.constEnd(); ++it)
+    {
+        if (it->address.compare(macAddress, Qt::CaseInsensitive) == 0)
+        {
+            return it.key();
+        }
+    }
+    return QString();
+}
+
+void BluetoothMonitor::callDeviceMethod(const QString &macAddress, const QString &method)
+{
+    const bool isConnect = (method == "Connect");
+
+    const QString path = devicePathForAddress(macAddress);
+    if (path.isEmpty())
+    {
+        LOG_WARN("No BlueZ device found for address " << macAddress << ", cannot " << method);
+        const QString error = QStringLiteral("device not found");
+        if (isConnect) emit connectFinished(macAddress, false, error);
+        else emit disconnectFinished(macAddress, false, error);
+        return;
+    }
+
+    QDBusMessage call = QDBusMessage::createMethodCall("org.bluez", path, "org.bluez.Device1", method);
+    // Connect can legitimately take several seconds on a slow controller;
+    // the call is async so only the watcher waits, not the GUI thread
+    MetricsRegistry::instance().add(MetricsRegistry::DBusCallsIssued);
+    QDBusPendingCall pending = m_dbus.asyncCall(call, 30000);
+    auto *watcher = new QDBusPendingCallWatcher(pending, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, macAddress, isConnect](QDBusPendingCallWatcher *watcher)
+    {
+        watcher->deleteLater();
+        QDBusPendingReply<> reply = *watcher;
+        const bool success = !reply.isError();
+        if (!success)
+        {
+            MetricsRegistry::instance().add(MetricsRegistry::DBusCallsFailed);
+        }
+        const QString error = success ? QString() : reply.error().message();
+        if (isConnect) emit connectFinished(macAddress, success, error);
+        else emit disconnectFinished(macAddress, success, error);
+    });
+}
+
+void BluetoothMonitor::connectDevice(const QString &macAddress)
+{
+    callDeviceMethod(macAddress, "Connect");
+}
+
+void BluetoothMonitor::disconnectDevice(const QString &macAddress)
+{
+    callDeviceMethod(macAddress, "Disconnect");
+}
+
+void BluetoothMonitor::onInterfacesAdded(const QDBusObjectPath &objectPath, const InterfaceList &interfaces)
+{
+    if (interfaces.contains("org.bluez.Device1"))
+    {
+        cacheDeviceProperties(objectPath.path(), interfaces.value("org.bluez.Device1"));
+    }
+}
+
+void BluetoothMonitor::onInterfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces)
+{
+    if (interfaces.contains("org.bluez.Device1"))
+    {
+        m_devices.remove(objectPath.path());
+    }
+}
+
 void BluetoothMonitor::onPropertiesChanged(const QString &interface, const QVariantMap &changedProps, const QStringList &invalidatedProps)
 {
     Q_UNUSED(invalidatedProps);
@@ -126,36 +299,38 @@ void BluetoothMonitor::onPropertiesChanged(const QString &interface, const QVari
         return;
     }
 
-    if (changedProps.contains("Connected"))
-    {
-        bool connected = changedProps["Connected"].toBool();
-        QString path = QDBusContext::message().path();
+    QString path = QDBusContext::message().path();
 
-        if (!isAirPodsDevice(path))
+    // Keep the cached name/address in sync from the signal payload itself
+    if (changedProps.contains("Name") || changedProps.contains("Address") || changedProps.contains("UUIDs"))
+    {
+        if (m_devices.contains(path))
         {
-            return;
+            cacheDeviceProperties(path, changedProps);
         }
+    }
 
-        QDBusInterface deviceInterface("org.bluez", path, "org.freedesktop.DBus.Properties", m_dbus);
+    if (changedProps.contains("Connected"))
+    {
+        bool connected = changedProps["Connected"].toBool();
 
-        // Get the device address
-        QDBusReply<QVariant> addrReply = deviceInterface.call("Get", "org.bluez.Device1", "Address");
-        if (!addrReply.isValid())
+        // Answered from the cache: a Connected flip from a non-AirPods device
+        // costs a hash lookup, not three blocking round trips
+        const DeviceRecord &record = lookupDevice(path);
+        if (!record.isAirPods)
         {
             return;
         }
-        QString macAddress = addrReply.value().toString();
-        QString deviceName = getDeviceName(path);
 
         if (connected)
         {
-            emit deviceConnected(macAddress, deviceName);
-            LOG_DEBUG("AirPods device connected:" << macAddress << " Name:" << deviceName);
+            emit deviceConnected(record.address, record.name);
+            LOG_DEBUG("AirPods device connected:" << record.address << " Name:" << record.name);
         }
         else
         {
-            emit deviceDisconnected(macAddress, deviceName);
-            LOG_DEBUG("AirPods device disconnected:" << macAddress << " Name:" << deviceName);
+            emit deviceDisconnected(record.address, record.name);
+            LOG_DEBUG("AirPods device disconnected:" << record.address << " Name:" << record.name);
         }
     }
-}
\ No newline at end of file
+}
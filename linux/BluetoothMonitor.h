@@ -2,11 +2,14 @@
 #define BLUETOOTHMONITOR_H
 
 #include <QObject>
+#include <QHash>
 #include <QtDBus/QtDBus>
 
 // Forward declarations for D-Bus types
 typedef QMap<QDBusObjectPath, QMap<QString, QVariantMap>> ManagedObjectList;
 Q_DECLARE_METATYPE(ManagedObjectList)
+typedef QMap<QString, QVariantMap> InterfaceList;
+Q_DECLARE_METATYPE(InterfaceList)
 
 class BluetoothMonitor : public QObject, protected QDBusContext
 {
@@ -17,18 +20,44 @@ public:
 
     bool checkAlreadyConnectedDevices();
 
+    // Async org.bluez.Device1.Connect/Disconnect on the bus this monitor
+    // already holds; completion is reported via the *Finished signals so the
+    // GUI thread never blocks on the controller.
+    void connectDevice(const QString &macAddress);
+    void disconnectDevice(const QString &macAddress);
+
 signals:
     void deviceConnected(const QString &macAddress, const QString &deviceName);
     void deviceDisconnected(const QString &macAddress, const QString &deviceName);
+    void connectFinished(const QString &macAddress, bool success, const QString &error);
+    void disconnectFinished(const QString &macAddress, bool success, const QString &error);
 
 private slots:
     void onPropertiesChanged(const QString &interface, const QVariantMap &changedProps, const QStringList &invalidatedProps);
+    void onInterfacesAdded(const QDBusObjectPath &objectPath, const InterfaceList &interfaces);
+    void onInterfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces);
 
 private:
+    // What onPropertiesChanged needs to know about a device, resolved once
+    // per object path instead of with blocking Get calls per signal
+    struct DeviceRecord
+    {
+        bool isAirPods = false;
+        QString address;
+        QString name;
+    };
+
     QDBusConnection m_dbus;
+    QHash<QString, DeviceRecord> m_devices;
+
     void registerDBusService();
+    void refreshDeviceCache();
+    QString devicePathForAddress(const QString &macAddress) const;
+    void callDeviceMethod(const QString &macAddress, const QString &method);
+    void cacheDeviceProperties(const QString &devicePath, const QVariantMap &deviceProps);
+    const DeviceRecord &lookupDevice(const QString &devicePath);
     bool isAirPodsDevice(const QString &devicePath);
     QString getDeviceName(const QString &devicePath);
 };
 
-#endif // BLUETOOTHMONITOR_H
\ No newline at end of file
+#endif // BLUETOOTHMONITOR_H
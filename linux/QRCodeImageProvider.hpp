@@ -1,13 +1,51 @@
-#include <QQuickImageProvider>
-#include <QPainter>
+#pragma once
+
+#include <QQuickAsyncImageProvider>
+#include <QQuickImageResponse>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QHash>
+#include <QImage>
+#include <algorithm>
+#include <cstring>
 #include "thirdparty/QR-Code-generator/qrcodegen.hpp"
 
-class QRCodeImageProvider : public QQuickImageProvider
+class QRCodeImageResponse : public QQuickImageResponse, public QRunnable
 {
 public:
-    QRCodeImageProvider() : QQuickImageProvider(QQuickImageProvider::Image) {}
+    QRCodeImageResponse(const QString &id, QMutex *cacheMutex, QHash<QString, QImage> *cache)
+        : m_id(id), m_cacheMutex(cacheMutex), m_cache(cache)
+    {
+        // Qt Quick owns the response; the thread pool must not delete it
+        setAutoDelete(false);
+    }
+
+    QQuickTextureFactory *textureFactory() const override
+    {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+    // Worker-thread path: encode, render, publish to the cache
+    void run() override
+    {
+        m_image = render(m_id);
+        {
+            QMutexLocker locker(m_cacheMutex);
+            m_cache->insert(m_id, m_image);
+        }
+        emit finished();
+    }
+
+    // Cache-hit path: the image is already set; finished() may only fire
+    // after the caller holds the response, hence the queued emission
+    void finishWithCachedImage(const QImage &image)
+    {
+        m_image = image;
+        QMetaObject::invokeMethod(this, [this]() { emit finished(); }, Qt::QueuedConnection);
+    }
 
-    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override
+    static QImage render(const QString &id)
     {
         // Parse the keys from id (format: "encKey;irk")
         QStringList keys = id.split(';');
@@ -20,27 +58,70 @@ public:
         // Generate QR code using the existing qrcodegen library
         qrcodegen::QrCode qr = qrcodegen::QrCode::encodeText(data.toUtf8().constData(), qrcodegen::QrCode::Ecc::MEDIUM);
 
-        int scale = 8;
-        QImage image(qr.getSize() * scale, qr.getSize() * scale, QImage::Format_RGB32);
-        image.fill(Qt::white);
+        const int scale = 8;
+        const int modules = qr.getSize();
+        QImage image(modules * scale, modules * scale, QImage::Format_RGB32);
 
-        QPainter painter(&image);
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(Qt::black);
+        // Rasterize directly into the scanlines: one pixel run per module,
+        // then duplicate the finished row across its band. No paint engine,
+        // no per-module draw calls.
+        const QRgb dark = qRgb(0, 0, 0);
+        const QRgb light = qRgb(255, 255, 255);
 
-        for (int y = 0; y < qr.getSize(); y++)
+        for (int y = 0; y < modules; y++)
         {
-            for (int x = 0; x < qr.getSize(); x++)
+            const std::uint8_t *moduleRow = qr.moduleRow(y);
+            QRgb *row = reinterpret_cast<QRgb *>(image.scanLine(y * scale));
+            for (int x = 0; x < modules; x++)
             {
-                if (qr.getModule(x, y))
-                {
-                    painter.drawRect(x * scale, y * scale, scale, scale);
-                }
+                const QRgb color = moduleRow[x] ? dark : light;
+                std::fill(row + x * scale, row + (x + 1) * scale, color);
+            }
+
+            const uchar *src = image.constScanLine(y * scale);
+            for (int dy = 1; dy < scale; dy++)
+            {
+                memcpy(image.scanLine(y * scale + dy), src, image.bytesPerLine());
             }
         }
 
-        if (size)
-            *size = image.size();
         return image;
     }
-};
\ No newline at end of file
+
+private:
+    QString m_id;
+    QImage m_image;
+    QMutex *m_cacheMutex;
+    QHash<QString, QImage> *m_cache;
+};
+
+// Encodes off the render-request path: the first request for a key pair runs
+// on the thread pool, repeat requests (the settings dialog re-asks every time
+// it opens) are answered from the cache without re-encoding.
+class QRCodeImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override
+    {
+        Q_UNUSED(requestedSize);
+
+        auto *response = new QRCodeImageResponse(id, &m_cacheMutex, &m_cache);
+
+        {
+            QMutexLocker locker(&m_cacheMutex);
+            auto it = m_cache.constFind(id);
+            if (it != m_cache.constEnd())
+            {
+                response->finishWithCachedImage(*it);
+                return response;
+            }
+        }
+
+        QThreadPool::globalInstance()->start(response);
+        return response;
+    }
+
+private:
+    QMutex m_cacheMutex;
+    QHash<QString, QImage> m_cache;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <functional>
+
+// Framing layer for the AAP L2CAP read path. The socket drains into a
+// preallocated buffer and complete frames are handed to the sink as
+// QByteArray::fromRawData() slices over that buffer, so the hot path does no
+// per-packet heap allocation and no queued-connection marshalling copies.
+//
+// Frame boundaries come from a length probe (backed by the packet
+// dispatcher's registered fixed frame sizes): when the bytes at the front of
+// the buffer carry a header with a known exact length, exactly that many
+// bytes form the frame, which un-drops coalesced fixed-size packets that a
+// single readAll() used to merge. Headers without a fixed length consume the
+// remainder of the buffer as one frame, matching the old one-read-one-packet
+// behaviour for variable-length packets such as metadata.
+//
+// The slices passed to the sink alias the internal buffer and are only valid
+// for the duration of the callback; handlers that keep data must copy it.
+class AapFramer
+{
+public:
+    using FrameSink = std::function<void(const QByteArray &frame)>;
+    using LengthProbe = std::function<int(const QByteArray &frame)>;
+    using BatchEnd = std::function<void()>;
+
+    explicit AapFramer(int capacity = 4096)
+    {
+        m_buffer.reserve(capacity);
+    }
+
+    void setFrameSink(FrameSink sink) { m_sink = std::move(sink); }
+
+    // Invoked once after a drain that delivered at least one frame; batching
+    // stages (see streamstage.hpp) flush their accumulated samples here.
+    void setBatchEnd(BatchEnd hook) { m_batchEnd = std::move(hook); }
+
+    // The probe returns the exact frame length for the header at the start
+    // of the passed slice, or -1 when the length is unknown.
+    void setLengthProbe(LengthProbe probe) { m_lengthProbe = std::move(probe); }
+
+    // Drops any partially received frame, e.g. between connections.
+    void reset() { m_buffer.resize(0); }
+
+    // Pulls everything available from the device into the buffer and
+    // delivers the complete frames it now holds.
+    void drain(QIODevice *device)
+    {
+        const qint64 available = device->bytesAvailable();
+        if (available <= 0)
+        {
+            return;
+        }
+
+        const int oldSize = m_buffer.size();
+        m_buffer.resize(oldSize + static_cast<int>(available));
+        const qint64 read = device->read(m_buffer.data() + oldSize, available);
+        m_buffer.resize(oldSize + static_cast<int>(qMax<qint64>(read, 0)));
+
+        deliverFrames();
+    }
+
+private:
+    void deliverFrames()
+    {
+        if (!m_sink)
+        {
+            return;
+        }
+
+        int offset = 0;
+        int delivered = 0;
+        const int total = m_buffer.size();
+        while (offset < total)
+        {
+            const QByteArray rest = QByteArray::fromRawData(m_buffer.constData() + offset, total - offset);
+            int frameLength = m_lengthProbe ? m_lengthProbe(rest) : -1;
+            if (frameLength < 0)
+            {
+                frameLength = rest.size(); // Unknown length: remainder is one frame
+            }
+            if (frameLength > rest.size())
+            {
+                break; // Incomplete frame, wait for more data
+            }
+            m_sink(QByteArray::fromRawData(m_buffer.constData() + offset, frameLength));
+            offset += frameLength;
+            delivered++;
+        }
+
+        if (offset == m_buffer.size())
+        {
+            m_buffer.resize(0); // Keeps the reserved capacity
+        }
+        else if (offset > 0)
+        {
+            m_buffer.remove(0, offset);
+        }
+
+        if (delivered > 0 && m_batchEnd)
+        {
+            m_batchEnd();
+        }
+    }
+
+    QByteArray m_buffer;
+    FrameSink m_sink;
+    LengthProbe m_lengthProbe;
+    BatchEnd m_batchEnd;
+};
@@ -8,18 +8,28 @@
 
 #include "enums.h"
 #include "BasicControlCommand.hpp"
+#include "packethex.hpp"
 
+// The *_BYTES tables are constexpr and live in the binary's read-only
+// section; the QByteArray constants are zero-copy views over them, so no
+// packet constant parses hex or touches the heap at startup.
 namespace AirPodsPackets
 {
     // Noise Control Mode Packets
     namespace NoiseControl
     {
         using NoiseControlMode = AirpodsTrayApp::Enums::NoiseControlMode;
-        static const QByteArray HEADER = ControlCommand::HEADER + 0x0D;
-        static const QByteArray OFF = ControlCommand::createCommand(0x0D, 0x01);
-        static const QByteArray NOISE_CANCELLATION = ControlCommand::createCommand(0x0D, 0x02);
-        static const QByteArray TRANSPARENCY = ControlCommand::createCommand(0x0D, 0x03);
-        static const QByteArray ADAPTIVE = ControlCommand::createCommand(0x0D, 0x04);
+        inline constexpr auto HEADER_BYTES = PacketHex::append(ControlCommand::HEADER_BYTES, 0x0D);
+        inline constexpr auto OFF_BYTES = ControlCommand::commandBytes(0x0D, 0x01);
+        inline constexpr auto NOISE_CANCELLATION_BYTES = ControlCommand::commandBytes(0x0D, 0x02);
+        inline constexpr auto TRANSPARENCY_BYTES = ControlCommand::commandBytes(0x0D, 0x03);
+        inline constexpr auto ADAPTIVE_BYTES = ControlCommand::commandBytes(0x0D, 0x04);
+
+        static const QByteArray HEADER = PacketHex::view(HEADER_BYTES);
+        static const QByteArray OFF = PacketHex::view(OFF_BYTES);
+        static const QByteArray NOISE_CANCELLATION = PacketHex::view(NOISE_CANCELLATION_BYTES);
+        static const QByteArray TRANSPARENCY = PacketHex::view(TRANSPARENCY_BYTES);
+        static const QByteArray ADAPTIVE = PacketHex::view(ADAPTIVE_BYTES);
 
         static const QByteArray getPacketForMode(AirpodsTrayApp::Enums::NoiseControlMode mode)
         {
@@ -93,7 +103,8 @@ namespace AirPodsPackets
         static const QByteArray ENABLED = Type::ENABLED;
         static const QByteArray DISABLED = Type::DISABLED;
         static const QByteArray HEADER = Type::HEADER;
-        static const QByteArray DATA_HEADER = QByteArray::fromHex("040004004B00020001");
+        inline constexpr auto DATA_HEADER_BYTES = PacketHex::fromHex("040004004B00020001");
+        static const QByteArray DATA_HEADER = PacketHex::view(DATA_HEADER_BYTES);
         inline std::optional<bool> parseState(const QByteArray &data) { return Type::parseState(data); }
     }
 
@@ -120,50 +131,112 @@ namespace AirPodsPackets
     // Connection Packets
     namespace Connection
     {
-        static const QByteArray HANDSHAKE = QByteArray::fromHex("00000400010002000000000000000000");
-        static const QByteArray SET_SPECIFIC_FEATURES = QByteArray::fromHex("040004004d00d700000000000000");
-        static const QByteArray REQUEST_NOTIFICATIONS = QByteArray::fromHex("040004000f00ffffffffff");
-        static const QByteArray AIRPODS_DISCONNECTED = QByteArray::fromHex("00010000");
+        inline constexpr auto HANDSHAKE_BYTES = PacketHex::fromHex("00000400010002000000000000000000");
+        inline constexpr auto SET_SPECIFIC_FEATURES_BYTES = PacketHex::fromHex("040004004d00d700000000000000");
+        inline constexpr auto REQUEST_NOTIFICATIONS_BYTES = PacketHex::fromHex("040004000f00ffffffffff");
+        inline constexpr auto AIRPODS_DISCONNECTED_BYTES = PacketHex::fromHex("00010000");
+
+        static const QByteArray HANDSHAKE = PacketHex::view(HANDSHAKE_BYTES);
+        static const QByteArray SET_SPECIFIC_FEATURES = PacketHex::view(SET_SPECIFIC_FEATURES_BYTES);
+        static const QByteArray REQUEST_NOTIFICATIONS = PacketHex::view(REQUEST_NOTIFICATIONS_BYTES);
+        static const QByteArray AIRPODS_DISCONNECTED = PacketHex::view(AIRPODS_DISCONNECTED_BYTES);
     }
 
     // Phone Communication Packets
     namespace Phone
     {
-        static const QByteArray NOTIFICATION = QByteArray::fromHex("00040001");
-        static const QByteArray CONNECTED = QByteArray::fromHex("00010001");
-        static const QByteArray DISCONNECTED = QByteArray::fromHex("00010000");
-        static const QByteArray STATUS_REQUEST = QByteArray::fromHex("00020003");
-        static const QByteArray DISCONNECT_REQUEST = QByteArray::fromHex("00020000");
+        inline constexpr auto NOTIFICATION_BYTES = PacketHex::fromHex("00040001");
+        inline constexpr auto CONNECTED_BYTES = PacketHex::fromHex("00010001");
+        inline constexpr auto DISCONNECTED_BYTES = PacketHex::fromHex("00010000");
+        inline constexpr auto STATUS_REQUEST_BYTES = PacketHex::fromHex("00020003");
+        inline constexpr auto DISCONNECT_REQUEST_BYTES = PacketHex::fromHex("00020000");
+
+        static const QByteArray NOTIFICATION = PacketHex::view(NOTIFICATION_BYTES);
+        static const QByteArray CONNECTED = PacketHex::view(CONNECTED_BYTES);
+        static const QByteArray DISCONNECTED = PacketHex::view(DISCONNECTED_BYTES);
+        static const QByteArray STATUS_REQUEST = PacketHex::view(STATUS_REQUEST_BYTES);
+        static const QByteArray DISCONNECT_REQUEST = PacketHex::view(DISCONNECT_REQUEST_BYTES);
+    }
+
+    // Head Tracking Packets (proprietary sensor stream, reverse engineered
+    // by the Python prototype in head-tracking/)
+    namespace HeadTracking
+    {
+        inline constexpr auto START_BYTES = PacketHex::fromHex("04000400170000001000100008A102420B080E10021A0501409C0000");
+        inline constexpr auto STOP_BYTES = PacketHex::fromHex("040004001700000010001100087E1002420B084E10021A050100000000");
+        // Orientation packets arrive under two headers depending on which
+        // bud reports; both carry the same layout
+        inline constexpr auto DATA_HEADER_BYTES = PacketHex::fromHex("040004001700000010004500");
+        inline constexpr auto DATA_HEADER_ALT_BYTES = PacketHex::fromHex("040004001700000010004400");
+
+        static const QByteArray START = PacketHex::view(START_BYTES);
+        static const QByteArray STOP = PacketHex::view(STOP_BYTES);
+        static const QByteArray DATA_HEADER = PacketHex::view(DATA_HEADER_BYTES);
+        static const QByteArray DATA_HEADER_ALT = PacketHex::view(DATA_HEADER_ALT_BYTES);
+
+        // Orientation sits at fixed offsets inside the (variable-length)
+        // sensor packet; anything shorter carries no usable sample
+        inline constexpr int MIN_PACKET_SIZE = 80;
+        inline constexpr int HORIZONTAL_OFFSET = 51;
+        inline constexpr int VERTICAL_OFFSET = 53;
+
+        struct Orientation
+        {
+            qint16 horizontal;
+            qint16 vertical;
+        };
+
+        inline std::optional<Orientation> parseOrientation(const QByteArray &data)
+        {
+            if (data.size() < MIN_PACKET_SIZE)
+            {
+                return std::nullopt;
+            }
+            const auto *bytes = reinterpret_cast<const quint8 *>(data.constData());
+            Orientation out;
+            out.horizontal = static_cast<qint16>(bytes[HORIZONTAL_OFFSET] | (bytes[HORIZONTAL_OFFSET + 1] << 8));
+            out.vertical = static_cast<qint16>(bytes[VERTICAL_OFFSET] | (bytes[VERTICAL_OFFSET + 1] << 8));
+            return out;
+        }
     }
 
     // Adaptive Noise Packets
     namespace AdaptiveNoise
     {
-        const QByteArray HEADER = QByteArray::fromHex("0400040009002E");
+        inline constexpr auto HEADER_BYTES = PacketHex::fromHex("0400040009002E");
+        const QByteArray HEADER = PacketHex::view(HEADER_BYTES);
 
         inline QByteArray getPacket(int level)
         {
-            return HEADER + static_cast<char>(level) + QByteArray::fromHex("000000");
+            QByteArray packet = PacketHex::copy(HEADER_BYTES);
+            packet.append(static_cast<char>(level));
+            packet.append(3, '\0');
+            return packet;
         }
     }
 
     namespace Rename
     {
+        inline constexpr auto HEADER_BYTES = PacketHex::fromHex("040004001A0001");
+
         static QByteArray getPacket(const QString &newName)
         {
-            QByteArray nameBytes = newName.toUtf8();                   // Convert name to UTF-8
-            quint8 size = static_cast<char>(nameBytes.size());         // Name length (1 byte)
-            QByteArray packet = QByteArray::fromHex("040004001A0001"); // Header
-            packet.append(size);                                       // Append size byte
-            packet.append('\0');                                       // Append null byte
-            packet.append(nameBytes);                                  // Append name bytes
+            QByteArray nameBytes = newName.toUtf8();           // Convert name to UTF-8
+            quint8 size = static_cast<char>(nameBytes.size()); // Name length (1 byte)
+            QByteArray packet = PacketHex::copy(HEADER_BYTES); // Header
+            packet.append(size);                               // Append size byte
+            packet.append('\0');                               // Append null byte
+            packet.append(nameBytes);                          // Append name bytes
             return packet;
         }
     }
 
     namespace MagicPairing {
-        static const QByteArray REQUEST_MAGIC_CLOUD_KEYS = QByteArray::fromHex("0400040030000500");
-        static const QByteArray MAGIC_CLOUD_KEYS_HEADER = QByteArray::fromHex("04000400310002");
+        inline constexpr auto REQUEST_MAGIC_CLOUD_KEYS_BYTES = PacketHex::fromHex("0400040030000500");
+        inline constexpr auto MAGIC_CLOUD_KEYS_HEADER_BYTES = PacketHex::fromHex("04000400310002");
+
+        static const QByteArray REQUEST_MAGIC_CLOUD_KEYS = PacketHex::view(REQUEST_MAGIC_CLOUD_KEYS_BYTES);
+        static const QByteArray MAGIC_CLOUD_KEYS_HEADER = PacketHex::view(MAGIC_CLOUD_KEYS_HEADER_BYTES);
 
         struct MagicCloudKeys {
             QByteArray magicAccIRK;      // 16 bytes
@@ -213,11 +286,17 @@ namespace AirPodsPackets
     // Parsing Headers
     namespace Parse
     {
-        static const QByteArray EAR_DETECTION = QByteArray::fromHex("040004000600");
-        static const QByteArray BATTERY_STATUS = QByteArray::fromHex("040004000400");
-        static const QByteArray METADATA = QByteArray::fromHex("040004001d");
-        static const QByteArray HANDSHAKE_ACK = QByteArray::fromHex("01000400");
-        static const QByteArray FEATURES_ACK = QByteArray::fromHex("040004002b00"); // Note: Only tested with airpods pro 2
+        inline constexpr auto EAR_DETECTION_BYTES = PacketHex::fromHex("040004000600");
+        inline constexpr auto BATTERY_STATUS_BYTES = PacketHex::fromHex("040004000400");
+        inline constexpr auto METADATA_BYTES = PacketHex::fromHex("040004001d");
+        inline constexpr auto HANDSHAKE_ACK_BYTES = PacketHex::fromHex("01000400");
+        inline constexpr auto FEATURES_ACK_BYTES = PacketHex::fromHex("040004002b00"); // Note: Only tested with airpods pro 2
+
+        static const QByteArray EAR_DETECTION = PacketHex::view(EAR_DETECTION_BYTES);
+        static const QByteArray BATTERY_STATUS = PacketHex::view(BATTERY_STATUS_BYTES);
+        static const QByteArray METADATA = PacketHex::view(METADATA_BYTES);
+        static const QByteArray HANDSHAKE_ACK = PacketHex::view(HANDSHAKE_ACK_BYTES);
+        static const QByteArray FEATURES_ACK = PacketHex::view(FEATURES_ACK_BYTES);
     }
 }
 
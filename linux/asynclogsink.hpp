@@ -0,0 +1,156 @@
+#pragma once
+
+#include <QByteArray>
+#include <QSemaphore>
+#include <QString>
+#include <QThread>
+#include <QtGlobal>
+#include <atomic>
+#include <array>
+#include <cstdio>
+
+/**
+ * @brief Asynchronous log sink: formatting stays on the caller, I/O moves off it
+ *
+ * Enabled log lines are pushed into a fixed-size lock-free ring and written to
+ * stderr by a dedicated thread, so the packet path never blocks on terminal or
+ * pipe I/O. When the ring is full the line is dropped and counted rather than
+ * stalling the producer.
+ */
+class AsyncLogSink
+{
+public:
+    // Installs the sink as the Qt message handler and starts the writer
+    // thread. Call once, early in main().
+    static void install()
+    {
+        AsyncLogSink &sink = instance();
+        sink.m_previousHandler = qInstallMessageHandler(&AsyncLogSink::handleMessage);
+        sink.m_writer.start();
+    }
+
+    // Drains the ring and stops the writer; safe to call once at shutdown
+    static void shutdown()
+    {
+        AsyncLogSink &sink = instance();
+        if (!sink.m_running.exchange(false))
+        {
+            return;
+        }
+        sink.m_available.release(); // wake the writer so it can exit
+        sink.m_writer.wait();
+        sink.drainAll();
+    }
+
+private:
+    static constexpr int RING_SIZE = 1024; // power of two; index masks below
+
+    struct Slot
+    {
+        QByteArray line;
+        std::atomic<bool> ready{false};
+    };
+
+    class WriterThread : public QThread
+    {
+    public:
+        explicit WriterThread(AsyncLogSink *sink) : m_sink(sink) {}
+
+    protected:
+        void run() override
+        {
+            while (m_sink->m_running.load(std::memory_order_acquire))
+            {
+                m_sink->m_available.tryAcquire(1, 100);
+                m_sink->drainAll();
+            }
+        }
+
+    private:
+        AsyncLogSink *m_sink;
+    };
+
+    AsyncLogSink() : m_writer(this) {}
+
+    static AsyncLogSink &instance()
+    {
+        static AsyncLogSink sink;
+        return sink;
+    }
+
+    static void handleMessage(QtMsgType type, const QMessageLogContext &context, const QString &message)
+    {
+        AsyncLogSink &sink = instance();
+        if (!sink.m_running.load(std::memory_order_acquire))
+        {
+            if (sink.m_previousHandler)
+            {
+                sink.m_previousHandler(type, context, message);
+            }
+            return;
+        }
+
+        QByteArray line = qFormatLogMessage(type, context, message).toLocal8Bit();
+        line.append('\n');
+        sink.push(std::move(line));
+    }
+
+    void push(QByteArray &&line)
+    {
+        // Multi-producer claim; drop when the writer cannot keep up so the
+        // hot path never blocks
+        quint64 head = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (head - m_tail.load(std::memory_order_acquire) >= RING_SIZE)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel))
+            {
+                break;
+            }
+        }
+
+        Slot &slot = m_slots[head % RING_SIZE];
+        slot.line = std::move(line);
+        slot.ready.store(true, std::memory_order_release);
+        m_available.release();
+    }
+
+    void drainAll()
+    {
+        quint64 tail = m_tail.load(std::memory_order_relaxed);
+        while (tail < m_head.load(std::memory_order_acquire))
+        {
+            Slot &slot = m_slots[tail % RING_SIZE];
+            if (!slot.ready.load(std::memory_order_acquire))
+            {
+                break; // producer claimed the slot but has not published yet
+            }
+            fwrite(slot.line.constData(), 1, static_cast<size_t>(slot.line.size()), stderr);
+            slot.line.clear();
+            slot.ready.store(false, std::memory_order_release);
+            tail++;
+            m_tail.store(tail, std::memory_order_release);
+        }
+        fflush(stderr);
+
+        const quint64 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            fprintf(stderr, "AsyncLogSink: dropped %llu log lines\n",
+                    static_cast<unsigned long long>(dropped));
+        }
+    }
+
+    std::array<Slot, RING_SIZE> m_slots;
+    std::atomic<quint64> m_head{0};
+    std::atomic<quint64> m_tail{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<bool> m_running{true};
+    QSemaphore m_available;
+    QtMessageHandler m_previousHandler = nullptr;
+    WriterThread m_writer;
+};
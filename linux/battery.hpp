@@ -1,9 +1,12 @@
 #pragma once
 
 #include <QByteArray>
-#include <QMap>
+#include <QDateTime>
 #include <QString>
 #include <QObject>
+#include <QVariantList>
+#include <QVariantMap>
+#include <array>
 #include <climits>
 
 #include "airpods_packets.h"
@@ -32,10 +35,19 @@ public:
     void reset()
     {
         // Initialize all components to unknown state
-        states[Component::Left] = {};
-        states[Component::Right] = {};
-        states[Component::Case] = {};
-        emit batteryStatusChanged();
+        bool changed = false;
+        for (BatteryState &state : states)
+        {
+            if (state.level != 0 || state.status != BatteryStatus::Disconnected)
+            {
+                state = {};
+                changed = true;
+            }
+        }
+        if (changed)
+        {
+            emit batteryStatusChanged();
+        }
     }
 
     // Enum for AirPods components
@@ -77,7 +89,10 @@ public:
             return false; // Invalid count or size mismatch
         }
 
-        QMap<Component, BatteryState> newStates = states;
+        // Validate and collect first so a malformed entry rejects the whole
+        // packet without leaving partially applied state
+        std::array<std::pair<Component, BatteryState>, 3> parsed;
+        int parsedCount = 0;
 
         // Track pods to determine primary and secondary based on order
         QList<Component> podsInPacket;
@@ -101,7 +116,7 @@ public:
 
             if (status != BatteryStatus::Disconnected)
             {
-                newStates[comp] = {level, status};
+                parsed[parsedCount++] = {comp, {level, status}};
             }
 
             // If this is a pod (Left or Right), add it to the list
@@ -111,8 +126,12 @@ public:
             }
         }
 
-        // Update states
-        states = newStates;
+        // Update states; only actual deltas count
+        bool changed = false;
+        for (int i = 0; i < parsedCount; ++i)
+        {
+            changed |= setState(parsed[i].first, parsed[i].second);
+        }
 
         // Set primary and secondary pods based on order
         if (!podsInPacket.isEmpty())
@@ -129,8 +148,12 @@ public:
             secondaryPod = podsInPacket[1]; // Second pod is secondary
         }
 
-        // Emit signal to notify about battery status change
-        emit batteryStatusChanged();
+        // Notify only when something actually changed, so identical refreshes
+        // don't fan out through every QML binding
+        if (changed)
+        {
+            emit batteryStatusChanged();
+        }
 
         // Log which is left and right pod
         LOG_INFO("Primary Pod:" << primaryPod);
@@ -162,30 +185,40 @@ public:
         auto [isCaseCharging, rawCaseBattery] = formatBattery(rawCaseBatteryByte);
 
         if (rawLeftBattery == CHAR_MAX) {
-            rawLeftBattery = states.value(Component::Left).level; // Use last valid level
-            isLeftCharging = states.value(Component::Left).status == BatteryStatus::Charging;
+            rawLeftBattery = getState(Component::Left).level; // Use last valid level
+            isLeftCharging = getState(Component::Left).status == BatteryStatus::Charging;
         }
 
         if (rawRightBattery == CHAR_MAX) {
-            rawRightBattery = states.value(Component::Right).level; // Use last valid level
-            isRightCharging = states.value(Component::Right).status == BatteryStatus::Charging;
+            rawRightBattery = getState(Component::Right).level; // Use last valid level
+            isRightCharging = getState(Component::Right).status == BatteryStatus::Charging;
         }
 
         if (rawCaseBattery == CHAR_MAX) {
-            rawCaseBattery = states.value(Component::Case).level; // Use last valid level
-            isCaseCharging = states.value(Component::Case).status == BatteryStatus::Charging;
+            rawCaseBattery = getState(Component::Case).level; // Use last valid level
+            isCaseCharging = getState(Component::Case).status == BatteryStatus::Charging;
         }
 
-        // Update states
-        states[Component::Left] = {static_cast<quint8>(rawLeftBattery), isLeftCharging ? BatteryStatus::Charging : BatteryStatus::Discharging};
-        states[Component::Right] = {static_cast<quint8>(rawRightBattery), isRightCharging ? BatteryStatus::Charging : BatteryStatus::Discharging};
+        // Update states; advertisements repeat several times per second, so
+        // the delta check keeps unchanged refreshes out of the UI entirely
+        bool changed = setState(Component::Left, {static_cast<quint8>(rawLeftBattery), isLeftCharging ? BatteryStatus::Charging : BatteryStatus::Discharging});
+        changed |= setState(Component::Right, {static_cast<quint8>(rawRightBattery), isRightCharging ? BatteryStatus::Charging : BatteryStatus::Discharging});
         if (podInCase) {
-            states[Component::Case] = {static_cast<quint8>(rawCaseBattery), isCaseCharging ? BatteryStatus::Charging : BatteryStatus::Discharging};
+            changed |= setState(Component::Case, {static_cast<quint8>(rawCaseBattery), isCaseCharging ? BatteryStatus::Charging : BatteryStatus::Discharging});
         }
-        primaryPod = isLeftPodPrimary ? Component::Left : Component::Right;
+
+        Component newPrimaryPod = isLeftPodPrimary ? Component::Left : Component::Right;
         secondaryPod = isLeftPodPrimary ? Component::Right : Component::Left;
-        emit batteryStatusChanged();
-        emit primaryChanged();
+        if (newPrimaryPod != primaryPod)
+        {
+            primaryPod = newPrimaryPod;
+            emit primaryChanged();
+        }
+
+        if (changed)
+        {
+            emit batteryStatusChanged();
+        }
 
         return true;
     }
@@ -193,7 +226,7 @@ public:
     // Get the raw state for a component
     BatteryState getState(Component comp) const
     {
-        return states.value(comp, {});
+        return states[slotOf(comp)];
     }
 
     // Get a formatted status string including charging state
@@ -224,16 +257,35 @@ public:
         return QString("%1% (%2)").arg(state.level).arg(statusStr);
     }
 
+    // Timestamped level/status samples for one component, oldest first.
+    // Each entry: { timestamp (ms since epoch), level, charging }
+    Q_INVOKABLE QVariantList componentHistory(Component comp) const
+    {
+        const HistoryRing &ring = history[slotOf(comp)];
+        QVariantList result;
+        result.reserve(ring.count);
+        for (int i = 0; i < ring.count; ++i)
+        {
+            const HistorySample &sample = ring.samples[(ring.next - ring.count + i + HISTORY_CAPACITY) % HISTORY_CAPACITY];
+            QVariantMap entry;
+            entry["timestamp"] = sample.timestampMs;
+            entry["level"] = sample.level;
+            entry["charging"] = sample.status == BatteryStatus::Charging;
+            result.append(entry);
+        }
+        return result;
+    }
+
     Component getPrimaryPod() const { return primaryPod; }
     Component getSecondaryPod() const { return secondaryPod; }
 
-    quint8 getLeftPodLevel() const { return states.value(Component::Left).level; }
+    quint8 getLeftPodLevel() const { return getState(Component::Left).level; }
     bool isLeftPodCharging() const { return isStatus(Component::Left, BatteryStatus::Charging); }
     bool isLeftPodAvailable() const { return !isStatus(Component::Left, BatteryStatus::Disconnected); }
-    quint8 getRightPodLevel() const { return states.value(Component::Right).level; }
+    quint8 getRightPodLevel() const { return getState(Component::Right).level; }
     bool isRightPodCharging() const { return isStatus(Component::Right, BatteryStatus::Charging); }
     bool isRightPodAvailable() const { return !isStatus(Component::Right, BatteryStatus::Disconnected); }
-    quint8 getCaseLevel() const { return states.value(Component::Case).level; }
+    quint8 getCaseLevel() const { return getState(Component::Case).level; }
     bool isCaseCharging() const { return isStatus(Component::Case, BatteryStatus::Charging); }
     bool isCaseAvailable() const { return !isStatus(Component::Case, BatteryStatus::Disconnected); }
 
@@ -242,9 +294,59 @@ signals:
     void primaryChanged();
 
 private:
+    static constexpr int HISTORY_CAPACITY = 256;
+
+    struct HistorySample
+    {
+        qint64 timestampMs = 0;
+        quint8 level = 0;
+        BatteryStatus status = BatteryStatus::Disconnected;
+    };
+
+    // Bounded ring of the most recent samples for one component
+    struct HistoryRing
+    {
+        std::array<HistorySample, HISTORY_CAPACITY> samples;
+        int next = 0;
+        int count = 0;
+    };
+
+    // Components map to fixed slots instead of QMap nodes
+    static constexpr int slotOf(Component comp)
+    {
+        switch (comp)
+        {
+        case Component::Right: return 0;
+        case Component::Left: return 1;
+        case Component::Case: return 2;
+        }
+        return 0;
+    }
+
+    // Applies the new state; returns true and records a history sample only
+    // when level or status actually changed
+    bool setState(Component comp, const BatteryState &state)
+    {
+        BatteryState &current = states[slotOf(comp)];
+        if (current.level == state.level && current.status == state.status)
+        {
+            return false;
+        }
+        current = state;
+
+        HistoryRing &ring = history[slotOf(comp)];
+        ring.samples[ring.next] = {QDateTime::currentMSecsSinceEpoch(), state.level, state.status};
+        ring.next = (ring.next + 1) % HISTORY_CAPACITY;
+        if (ring.count < HISTORY_CAPACITY)
+        {
+            ring.count++;
+        }
+        return true;
+    }
+
     bool isStatus(Component component, BatteryStatus status) const
     {
-        return states.value(component).status == status;
+        return states[slotOf(component)].status == status;
     }
 
     std::pair<bool, int> formatBattery(unsigned char byteVal)
@@ -254,7 +356,8 @@ private:
         return std::make_pair(charging, level);
     }
 
-    QMap<Component, BatteryState> states;
-    Component primaryPod;
-    Component secondaryPod;
-};
\ No newline at end of file
+    std::array<BatteryState, 3> states{};
+    std::array<HistoryRing, 3> history{};
+    Component primaryPod = Component::Left;
+    Component secondaryPod = Component::Right;
+};
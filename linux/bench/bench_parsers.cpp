@@ -0,0 +1,242 @@
+// Parser microbenchmarks: replays a corpus of recorded AAP and BLE packet
+// shapes (see "AAP Definitions.md" and "Proximity Pairing Message.md")
+// through the pure parsing layers and reports ns/packet and allocs/packet.
+// Run before and after parser changes to catch performance regressions:
+//
+//     cmake -DLIBREPODS_BUILD_BENCH=ON ... && ./librepods_bench
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QVector>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "airpods_packets.h"
+#include "battery.hpp"
+#include "eardetection.hpp"
+#include "ble/blemanager.h"
+#include "logger.h"
+
+Q_LOGGING_CATEGORY(Librepods, "Librepods")
+
+// Global allocation counter: every operator new in the process ticks it, so
+// allocs/packet covers QByteArray copies, QList nodes and anything else the
+// parsers touch on the heap.
+static std::atomic<quint64> g_allocations{0};
+
+void *operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+
+constexpr int ITERATIONS = 2000;
+
+// Runs `parse` over the corpus ITERATIONS times and prints ns/packet and
+// allocs/packet. One warmup pass keeps cold caches and lazily-initialized
+// statics out of the numbers.
+template <typename Parse>
+void runBench(const char *name, const QVector<QByteArray> &corpus, Parse parse)
+{
+    for (const QByteArray &packet : corpus)
+    {
+        parse(packet);
+    }
+
+    const quint64 allocsBefore = g_allocations.load(std::memory_order_relaxed);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        for (const QByteArray &packet : corpus)
+        {
+            parse(packet);
+        }
+    }
+    const qint64 elapsedNs = timer.nsecsElapsed();
+    const quint64 allocs = g_allocations.load(std::memory_order_relaxed) - allocsBefore;
+
+    const qint64 packets = static_cast<qint64>(corpus.size()) * ITERATIONS;
+    std::printf("%-32s %9.1f ns/packet %7.2f allocs/packet (%lld packets)\n",
+                name,
+                static_cast<double>(elapsedNs) / packets,
+                static_cast<double>(allocs) / packets,
+                static_cast<long long>(packets));
+}
+
+// 04 00 04 00 04 00 <count> then 5 bytes per component:
+// <type> 01 <level> <status> 01
+QVector<QByteArray> batteryCorpus()
+{
+    QVector<QByteArray> corpus;
+    for (int i = 0; i < 64; i++)
+    {
+        QByteArray packet = QByteArray::fromHex("040004000400");
+        packet.append(static_cast<char>(0x03));
+        const quint8 level = static_cast<quint8>(20 + i % 80);
+        const char status = (i % 4 == 0) ? 0x01 : 0x02; // occasionally charging
+        for (quint8 type : {0x02, 0x04, 0x08})          // right, left, case
+        {
+            packet.append(static_cast<char>(type));
+            packet.append(static_cast<char>(0x01));
+            packet.append(static_cast<char>(level));
+            packet.append(status);
+            packet.append(static_cast<char>(0x01));
+        }
+        corpus.append(packet);
+    }
+    return corpus;
+}
+
+// 16-byte decrypted BLE battery payloads; bit 7 charging, bits 0-6 level
+QVector<QByteArray> encryptedBatteryCorpus()
+{
+    QVector<QByteArray> corpus;
+    for (int i = 0; i < 64; i++)
+    {
+        QByteArray packet(16, '\0');
+        packet[1] = static_cast<char>((i % 2 ? 0x80 : 0x00) | (20 + i % 80));
+        packet[2] = static_cast<char>(25 + i % 75);
+        packet[3] = static_cast<char>(0x80 | (30 + i % 70));
+        corpus.append(packet);
+    }
+    return corpus;
+}
+
+// 04 00 04 00 06 00 <primary> <secondary>
+QVector<QByteArray> earDetectionCorpus()
+{
+    QVector<QByteArray> corpus;
+    for (int i = 0; i < 16; i++)
+    {
+        QByteArray packet = QByteArray::fromHex("040004000600");
+        packet.append(static_cast<char>(i % 3));
+        packet.append(static_cast<char>((i / 3) % 3));
+        corpus.append(packet);
+    }
+    return corpus;
+}
+
+// 04 00 04 00 31 00 02 then two 16-byte TLV blocks (IRK, EncKey)
+QVector<QByteArray> magicCloudKeysCorpus()
+{
+    QVector<QByteArray> corpus;
+    for (int i = 0; i < 4; i++)
+    {
+        QByteArray packet = QByteArray::fromHex("04000400310002");
+        packet.append(static_cast<char>(0x01));
+        packet.append(QByteArray::fromHex("001000")); // length 16 + reserved
+        packet.append(QByteArray(16, static_cast<char>(0x10 + i)));
+        packet.append(static_cast<char>(0x04));
+        packet.append(QByteArray::fromHex("001000"));
+        packet.append(QByteArray(16, static_cast<char>(0x40 + i)));
+        corpus.append(packet);
+    }
+    return corpus;
+}
+
+QVector<QByteArray> noiseControlCorpus()
+{
+    return {AirPodsPackets::NoiseControl::OFF,
+            AirPodsPackets::NoiseControl::NOISE_CANCELLATION,
+            AirPodsPackets::NoiseControl::TRANSPARENCY,
+            AirPodsPackets::NoiseControl::ADAPTIVE};
+}
+
+// Proximity Pairing manufacturer payload: prefix, length, paired flag,
+// model, status, battery nibbles, flags/case, lid, color, connection state,
+// then the 16-byte encrypted payload
+QVector<QByteArray> proximityCorpus()
+{
+    QVector<QByteArray> corpus;
+    for (int i = 0; i < 64; i++)
+    {
+        QByteArray payload;
+        payload.append(static_cast<char>(0x07)); // Proximity Pairing prefix
+        payload.append(static_cast<char>(0x19)); // length
+        payload.append(static_cast<char>(0x01)); // paired
+        payload.append(static_cast<char>(0x14)); // AirPods Pro 2 (0x1420)
+        payload.append(static_cast<char>(0x20));
+        payload.append(static_cast<char>(0x20 | (i % 2 ? 0x0A : 0x00)));      // status
+        payload.append(static_cast<char>(((i % 10) << 4) | ((i + 3) % 10)));  // pod nibbles
+        payload.append(static_cast<char>(0x40 | (i % 10)));                   // flags + case
+        payload.append(static_cast<char>(i % 8));                             // lid counter
+        payload.append(static_cast<char>(0x00));                              // color: white
+        payload.append(static_cast<char>(0x04));                              // idle
+        payload.append(QByteArray(16, static_cast<char>(i)));                 // encrypted
+        corpus.append(payload);
+    }
+    return corpus;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Parsers log through the same macros as the app; benchmarking should
+    // measure the parse, not the logger
+    QLoggingCategory::setFilterRules(QStringLiteral("Librepods.info=false\n"
+                                                    "Librepods.debug=false\n"
+                                                    "Librepods.warning=false"));
+
+    std::printf("Replaying parser corpus, %d iterations per corpus\n", ITERATIONS);
+
+    Battery battery;
+    runBench("Battery::parsePacket", batteryCorpus(),
+             [&battery](const QByteArray &packet) { battery.parsePacket(packet); });
+
+    Battery encryptedBattery;
+    int flip = 0;
+    runBench("Battery::parseEncryptedPacket", encryptedBatteryCorpus(),
+             [&encryptedBattery, &flip](const QByteArray &packet)
+             { encryptedBattery.parseEncryptedPacket(packet, (flip++ % 2) == 0, true); });
+
+    EarDetection earDetection;
+    runBench("EarDetection::parseData", earDetectionCorpus(),
+             [&earDetection](const QByteArray &packet) { earDetection.parseData(packet); });
+
+    quint64 keyBytes = 0;
+    runBench("MagicPairing::parseMagicCloudKeys", magicCloudKeysCorpus(),
+             [&keyBytes](const QByteArray &packet)
+             { keyBytes += AirPodsPackets::MagicPairing::parseMagicCloudKeysPacket(packet).magicAccIRK.size(); });
+
+    quint64 modes = 0;
+    runBench("NoiseControl::parseMode", noiseControlCorpus(),
+             [&modes](const QByteArray &packet)
+             { modes += AirPodsPackets::NoiseControl::parseMode(packet).has_value(); });
+
+    quint64 decoded = 0;
+    runBench("BleManager proximity decode", proximityCorpus(),
+             [&decoded](const QByteArray &packet)
+             {
+                 BleInfo info;
+                 decoded += BleManager::decodeProximityMessage(packet, info);
+             });
+
+    // Keep the accumulators observable so the calls cannot be elided
+    return (keyBytes + modes + decoded) == 0 ? 1 : 0;
+}
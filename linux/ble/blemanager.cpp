@@ -1,5 +1,6 @@
 #include "blemanager.h"
 #include "enums.h"
+#include "metricsregistry.hpp"
 #include <QDebug>
 #include <QTimer>
 #include "logger.h"
@@ -85,7 +86,11 @@ QString getConnectionStateName(BleInfo::ConnectionState state)
 BleManager::BleManager(QObject *parent) : QObject(parent)
 {
     discoveryAgent = new QBluetoothDeviceDiscoveryAgent(this);
-    discoveryAgent->setLowEnergyDiscoveryTimeout(0); // Continuous scanning
+    discoveryAgent->setLowEnergyDiscoveryTimeout(SCAN_WINDOW_MS); // Duty-cycled scan window
+
+    m_scanCycleTimer = new QTimer(this);
+    m_scanCycleTimer->setSingleShot(true);
+    connect(m_scanCycleTimer, &QTimer::timeout, this, &BleManager::startScanWindow);
 
     connect(discoveryAgent, &QBluetoothDeviceDiscoveryAgent::deviceDiscovered,
             this, &BleManager::onDeviceDiscovered);
@@ -102,125 +107,260 @@ BleManager::~BleManager()
 
 void BleManager::startScan()
 {
-    LOG_DEBUG("Starting BLE scan...");
-    discoveryAgent->start(QBluetoothDeviceDiscoveryAgent::LowEnergyMethod);
+    if (m_schedulerActive)
+    {
+        return;
+    }
+    LOG_DEBUG("Starting duty-cycled BLE scan...");
+    m_schedulerActive = true;
+    startScanWindow();
 }
 
 void BleManager::stopScan()
 {
     LOG_DEBUG("Stopping BLE scan...");
+    m_schedulerActive = false;
+    m_scanCycleTimer->stop();
     discoveryAgent->stop();
 }
 
 bool BleManager::isScanning() const
 {
-    return discoveryAgent->isActive();
+    return m_schedulerActive;
 }
 
-void BleManager::onDeviceDiscovered(const QBluetoothDeviceInfo &info)
+void BleManager::boostScan()
 {
-    // Check for Apple's manufacturer ID (0x004C)
-    if (info.manufacturerData().contains(0x004C))
+    m_boostUntil = QDateTime::currentDateTime().addSecs(BOOST_DURATION_SECS);
+    if (!m_schedulerActive)
     {
-        QByteArray data = info.manufacturerData().value(0x004C);
-        // Ensure data is long enough and starts with prefix 0x07 (indicates Proximity Pairing Message)
-        if (data.size() >= 10 && data[0] == 0x07)
-        {
-            QString address = info.address().toString();
-            BleInfo deviceInfo;
-            deviceInfo.name = info.name().isEmpty() ? "AirPods" : info.name();
-            deviceInfo.address = address;
-            deviceInfo.rawData = data.left(data.size() - 16);
-            deviceInfo.encryptedPayload = data.mid(data.size() - 16);
+        startScan();
+    }
+    else if (m_scanCycleTimer->isActive())
+    {
+        // Cut the current idle gap short and scan now
+        m_scanCycleTimer->stop();
+        startScanWindow();
+    }
+}
 
-            // data[1] is the length of the data, so we can skip it
+void BleManager::notePairedDeviceSeen()
+{
+    m_pairedLastSeen = QDateTime::currentDateTime();
+}
 
-            // Check if pairing mode is paired (0x01) or pairing (0x00)
-            if (data[2] == 0x00)
-            {
-                return; // Skip pairing mode devices (the values are differently structured)
-            }
+void BleManager::startScanWindow()
+{
+    if (!m_schedulerActive || discoveryAgent->isActive())
+    {
+        return;
+    }
+    discoveryAgent->start(QBluetoothDeviceDiscoveryAgent::LowEnergyMethod);
+}
+
+int BleManager::idleIntervalMs() const
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    if (m_boostUntil.isValid() && now < m_boostUntil)
+    {
+        return IDLE_AGGRESSIVE_MS;
+    }
+    if (m_pairedLastSeen.isValid() && m_pairedLastSeen.secsTo(now) < PAIRED_SEEN_RECENTLY_SECS)
+    {
+        return IDLE_SPARSE_MS; // Device is around and fresh; save the radio
+    }
+    return IDLE_DEFAULT_MS;
+}
+
+bool BleManager::decodeProximityMessage(const QByteArray &data, BleInfo &out)
+{
+    // Ensure data is long enough and starts with prefix 0x07 (Proximity
+    // Pairing Message)
+    if (data.size() < 10 || data[0] != 0x07)
+    {
+        return false;
+    }
+
+    // data[1] is the length of the data, so we can skip it
+
+    // Check if pairing mode is paired (0x01) or pairing (0x00)
+    if (data[2] == 0x00)
+    {
+        return false; // Skip pairing mode devices (the values are differently structured)
+    }
+
+    out.rawData = data.left(data.size() - 16);
+    out.encryptedPayload = data.mid(data.size() - 16);
 
-            
-            // Parse device model (big-endian: high byte at data[3], low byte at data[4])
-            deviceInfo.modelName = getModelName(static_cast<quint16>(data[4]) | (static_cast<quint8>(data[3]) << 8));
+    // Parse device model (big-endian: high byte at data[3], low byte at data[4])
+    out.modelName = getModelName(static_cast<quint16>(data[4]) | (static_cast<quint8>(data[3]) << 8));
 
-            // Status byte for primary pod and other flags
-            quint8 status = static_cast<quint8>(data[5]);
-            deviceInfo.status = status;
+    // Status byte for primary pod and other flags
+    quint8 status = static_cast<quint8>(data[5]);
+    out.status = status;
 
-            // Pods battery byte (upper nibble: one pod, lower nibble: other pod)
-            quint8 podsBatteryByte = static_cast<quint8>(data[6]);
+    // Pods battery byte (upper nibble: one pod, lower nibble: other pod)
+    quint8 podsBatteryByte = static_cast<quint8>(data[6]);
 
-            // Flags and case battery byte (upper nibble: case battery, lower nibble: flags)
-            quint8 flagsAndCaseBattery = static_cast<quint8>(data[7]);
+    // Flags and case battery byte (upper nibble: case battery, lower nibble: flags)
+    quint8 flagsAndCaseBattery = static_cast<quint8>(data[7]);
 
-            // Lid open counter and device color
-            quint8 lidIndicator = static_cast<quint8>(data[8]);
-            deviceInfo.color = getColorName((quint8)(data[9]));
+    // Lid open counter and device color
+    quint8 lidIndicator = static_cast<quint8>(data[8]);
+    out.color = getColorName((quint8)(data[9]));
 
-            deviceInfo.connectionState = static_cast<BleInfo::ConnectionState>(data[10]);
+    out.connectionState = static_cast<BleInfo::ConnectionState>(data[10]);
 
-            // Next: Encrypted Payload: 16 bytes
+    // Next: Encrypted Payload: 16 bytes
 
-            // Determine primary pod (bit 5 of status) and value flipping
-            bool primaryLeft = (status & 0x20) != 0; // Bit 5: 1 = left primary, 0 = right primary
-            bool areValuesFlipped = !primaryLeft;    // Flipped when right pod is primary
+    // Determine primary pod (bit 5 of status) and value flipping
+    bool primaryLeft = (status & 0x20) != 0; // Bit 5: 1 = left primary, 0 = right primary
+    bool areValuesFlipped = !primaryLeft;    // Flipped when right pod is primary
 
-            deviceInfo.primaryLeft = primaryLeft; // Store primary pod information
+    out.primaryLeft = primaryLeft; // Store primary pod information
 
-            // Parse battery levels
-            int leftNibble = areValuesFlipped ? (podsBatteryByte >> 4) & 0x0F : podsBatteryByte & 0x0F;
-            int rightNibble = areValuesFlipped ? podsBatteryByte & 0x0F : (podsBatteryByte >> 4) & 0x0F;
-            deviceInfo.leftPodBattery = (leftNibble == 15) ? -1 : leftNibble * 10;
-            deviceInfo.rightPodBattery = (rightNibble == 15) ? -1 : rightNibble * 10;
-            int caseNibble = flagsAndCaseBattery & 0x0F; // Extracts lower nibble
-            deviceInfo.caseBattery = (caseNibble == 15) ? -1 : caseNibble * 10;
+    // Parse battery levels
+    int leftNibble = areValuesFlipped ? (podsBatteryByte >> 4) & 0x0F : podsBatteryByte & 0x0F;
+    int rightNibble = areValuesFlipped ? podsBatteryByte & 0x0F : (podsBatteryByte >> 4) & 0x0F;
+    out.leftPodBattery = (leftNibble == 15) ? -1 : leftNibble * 10;
+    out.rightPodBattery = (rightNibble == 15) ? -1 : rightNibble * 10;
+    int caseNibble = flagsAndCaseBattery & 0x0F; // Extracts lower nibble
+    out.caseBattery = (caseNibble == 15) ? -1 : caseNibble * 10;
 
-            // Parse charging statuses from flags (uper 4 bits of data[7])
-            quint8 flags = (flagsAndCaseBattery >> 4) & 0x0F;                                        // Extracts lower nibble
-            deviceInfo.rightCharging = areValuesFlipped ? (flags & 0x01) != 0 : (flags & 0x02) != 0; // Depending on primary, bit 0 or 1
-            deviceInfo.leftCharging = areValuesFlipped ? (flags & 0x02) != 0 : (flags & 0x01) != 0;  // Depending on primary, bit 1 or 0
-            deviceInfo.caseCharging = (flags & 0x04) != 0;                                           // bit 2
+    // Parse charging statuses from flags (uper 4 bits of data[7])
+    quint8 flags = (flagsAndCaseBattery >> 4) & 0x0F;                                 // Extracts lower nibble
+    out.rightCharging = areValuesFlipped ? (flags & 0x01) != 0 : (flags & 0x02) != 0; // Depending on primary, bit 0 or 1
+    out.leftCharging = areValuesFlipped ? (flags & 0x02) != 0 : (flags & 0x01) != 0;  // Depending on primary, bit 1 or 0
+    out.caseCharging = (flags & 0x04) != 0;                                           // bit 2
 
-            // Additional status flags from status byte (data[5])
-            deviceInfo.isThisPodInTheCase = (status & 0x40) != 0; // Bit 6
-            deviceInfo.isOnePodInCase = (status & 0x10) != 0;     // Bit 4
-            deviceInfo.areBothPodsInCase = (status & 0x04) != 0;  // Bit 2
+    // Additional status flags from status byte (data[5])
+    out.isThisPodInTheCase = (status & 0x40) != 0; // Bit 6
+    out.isOnePodInCase = (status & 0x10) != 0;     // Bit 4
+    out.areBothPodsInCase = (status & 0x04) != 0;  // Bit 2
 
-            // In-ear detection with XOR logic
-            bool xorFactor = areValuesFlipped ^ deviceInfo.isThisPodInTheCase;
-            deviceInfo.isLeftPodInEar = xorFactor ? (status & 0x08) != 0 : (status & 0x02) != 0;  // Bit 3 or 1
-            deviceInfo.isRightPodInEar = xorFactor ? (status & 0x02) != 0 : (status & 0x08) != 0; // Bit 1 or 3
+    // In-ear detection with XOR logic
+    bool xorFactor = areValuesFlipped ^ out.isThisPodInTheCase;
+    out.isLeftPodInEar = xorFactor ? (status & 0x08) != 0 : (status & 0x02) != 0;  // Bit 3 or 1
+    out.isRightPodInEar = xorFactor ? (status & 0x02) != 0 : (status & 0x08) != 0; // Bit 1 or 3
 
-            // Determine primary and secondary in-ear status
-            deviceInfo.isPrimaryInEar = primaryLeft ? deviceInfo.isLeftPodInEar : deviceInfo.isRightPodInEar;
-            deviceInfo.isSecondaryInEar = primaryLeft ? deviceInfo.isRightPodInEar : deviceInfo.isLeftPodInEar;
+    // Determine primary and secondary in-ear status
+    out.isPrimaryInEar = primaryLeft ? out.isLeftPodInEar : out.isRightPodInEar;
+    out.isSecondaryInEar = primaryLeft ? out.isRightPodInEar : out.isLeftPodInEar;
 
-            // Microphone status
-            deviceInfo.isLeftPodMicrophone = primaryLeft ^ deviceInfo.isThisPodInTheCase;
-            deviceInfo.isRightPodMicrophone = !primaryLeft ^ deviceInfo.isThisPodInTheCase;
+    // Microphone status
+    out.isLeftPodMicrophone = primaryLeft ^ out.isThisPodInTheCase;
+    out.isRightPodMicrophone = !primaryLeft ^ out.isThisPodInTheCase;
+
+    out.lidOpenCounter = lidIndicator & 0x07;                          // Extract bits 0-2 (count)
+    quint8 lidState = static_cast<quint8>((lidIndicator >> 3) & 0x01); // Extract bit 3 (lid state)
+    if (out.isThisPodInTheCase)
+    {
+        out.lidState = static_cast<BleInfo::LidState>(lidState);
+    }
 
-            deviceInfo.lidOpenCounter = lidIndicator & 0x07; // Extract bits 0-2 (count)
-            quint8 lidState = static_cast<quint8>((lidIndicator >> 3) & 0x01); // Extract bit 3 (lid state)
-            if (deviceInfo.isThisPodInTheCase) {
-                deviceInfo.lidState = static_cast<BleInfo::LidState>(lidState);
+    return true;
+}
+
+void BleManager::onDeviceDiscovered(const QBluetoothDeviceInfo &info)
+{
+    // Check for Apple's manufacturer ID (0x004C)
+    if (info.manufacturerData().contains(0x004C))
+    {
+        QByteArray data = info.manufacturerData().value(0x004C);
+        // Ensure data is long enough and starts with prefix 0x07 (indicates Proximity Pairing Message)
+        if (data.size() >= 10 && data[0] == 0x07)
+        {
+            QString address = info.address().toString();
+            const QDateTime now = QDateTime::currentDateTime();
+            MetricsRegistry::instance().add(MetricsRegistry::AdvertsSeen);
+
+            // Dedup stage: AirPods rebroadcast the identical payload several
+            // times per second, and everything downstream (AES IRK check,
+            // payload decryption) runs per emission. Drop repeats before
+            // parsing anything.
+            const size_t payloadHash = qHash(data);
+            auto seen = m_seenAdverts.find(address);
+            if (seen != m_seenAdverts.end() && seen->payloadHash == payloadHash)
+            {
+                seen->lastSeen = now;
+                MetricsRegistry::instance().add(MetricsRegistry::AdvertsDeduped);
+                return;
             }
 
-            // Update timestamp
-            deviceInfo.lastSeen = QDateTime::currentDateTime();
+            BleInfo deviceInfo;
+            if (!decodeProximityMessage(data, deviceInfo))
+            {
+                return; // Pairing-mode frames are structured differently
+            }
+            deviceInfo.name = info.name().isEmpty() ? "AirPods" : info.name();
+            deviceInfo.address = address;
+            deviceInfo.lastSeen = now;
+
+            const quint8 status = deviceInfo.status;
+            const quint8 flags = (static_cast<quint8>(data[7]) >> 4) & 0x0F;
+
+            // Delta stage: only emit when the state downstream actually
+            // consumes (battery, charging, ear, lid, connection) changed
+            QByteArray stateKey;
+            stateKey.append(static_cast<char>(deviceInfo.leftPodBattery));
+            stateKey.append(static_cast<char>(deviceInfo.rightPodBattery));
+            stateKey.append(static_cast<char>(deviceInfo.caseBattery));
+            stateKey.append(static_cast<char>(status));
+            stateKey.append(static_cast<char>((flags << 4) | deviceInfo.lidOpenCounter));
+            stateKey.append(static_cast<char>(deviceInfo.lidState));
+            stateKey.append(static_cast<char>(deviceInfo.connectionState));
+
+            const bool stateChanged = (seen == m_seenAdverts.end() || seen->stateKey != stateKey);
+            if (seen != m_seenAdverts.end())
+            {
+                seen->payloadHash = payloadHash;
+                seen->stateKey = stateKey;
+                seen->lastSeen = now;
+            }
+            else
+            {
+                m_seenAdverts.insert(address, {payloadHash, stateKey, now});
+                pruneSeenAdverts(now);
+            }
+            MetricsRegistry::instance().set(MetricsRegistry::SeenAdvertTableSize, m_seenAdverts.size());
+
+            if (stateChanged)
+            {
+                MetricsRegistry::instance().add(MetricsRegistry::AdvertsEmitted);
+                emit deviceFound(deviceInfo); // Emit signal for device found
+            }
+        }
+    }
+}
 
-            emit deviceFound(deviceInfo); // Emit signal for device found
+// RPAs rotate roughly every 15 minutes, so stale addresses pile up in a
+// busy office; drop entries not seen for a while once the table grows.
+void BleManager::pruneSeenAdverts(const QDateTime &now)
+{
+    if (m_seenAdverts.size() <= 64)
+    {
+        return;
+    }
+    for (auto it = m_seenAdverts.begin(); it != m_seenAdverts.end();)
+    {
+        if (it->lastSeen.secsTo(now) > 20 * 60)
+        {
+            it = m_seenAdverts.erase(it);
+        }
+        else
+        {
+            ++it;
         }
     }
 }
 
 void BleManager::onScanFinished()
 {
-    if (discoveryAgent->isActive())
+    if (!m_schedulerActive)
     {
-        discoveryAgent->start(QBluetoothDeviceDiscoveryAgent::LowEnergyMethod);
+        return;
     }
+    m_scanCycleTimer->start(idleIntervalMs()); // Idle gap before the next window
 }
 
 void BleManager::onErrorOccurred(QBluetoothDeviceDiscoveryAgent::Error error)
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QBluetoothDeviceDiscoveryAgent>
 #include <QMap>
+#include <QHash>
 #include <QString>
 #include <QDateTime>
 #include "enums.h"
@@ -70,20 +71,64 @@ public:
     explicit BleManager(QObject *parent = nullptr);
     ~BleManager();
 
+    // Begins duty-cycled scanning (scan window, idle gap, repeat). The idle
+    // gap adapts: short after boostScan(), long while the paired device's
+    // RPA has been seen recently.
     void startScan();
     void stopScan();
+    // True while the scheduler is active, including idle gaps between windows
     bool isScanning() const;
 
+    // Scans aggressively for a while, e.g. after system wake or a disconnect
+    void boostScan();
+
+    // Called when an advertisement resolved to the paired device; recently
+    // seen devices only need a sparse duty cycle.
+    void notePairedDeviceSeen();
+
+    // Pure decode of an Apple Proximity Pairing payload (manufacturer data
+    // 0x004C) into `out`; returns false for non-proximity or pairing-mode
+    // frames. Static so it can be exercised standalone (see bench/).
+    static bool decodeProximityMessage(const QByteArray &data, BleInfo &out);
+
 private slots:
     void onDeviceDiscovered(const QBluetoothDeviceInfo &info);
     void onScanFinished();
     void onErrorOccurred(QBluetoothDeviceDiscoveryAgent::Error error);
+    void startScanWindow();
 
 signals:
     void deviceFound(const BleInfo &device);
 
 private:
+    // Per-address record of the last advertisement, used to suppress the
+    // identical frames AirPods rebroadcast several times per second and to
+    // hold back deviceFound until parsed state actually changed.
+    struct SeenAdvert
+    {
+        size_t payloadHash = 0;
+        QByteArray stateKey;
+        QDateTime lastSeen;
+    };
+
+    void pruneSeenAdverts(const QDateTime &now);
+    int idleIntervalMs() const;
+
+    // Duty cycle parameters: the radio is only on for SCAN_WINDOW_MS out of
+    // each window + idle period instead of scanning continuously.
+    static constexpr int SCAN_WINDOW_MS = 2000;
+    static constexpr int IDLE_DEFAULT_MS = 4000;
+    static constexpr int IDLE_SPARSE_MS = 8000;
+    static constexpr int IDLE_AGGRESSIVE_MS = 500;
+    static constexpr int BOOST_DURATION_SECS = 30;
+    static constexpr int PAIRED_SEEN_RECENTLY_SECS = 60;
+
     QBluetoothDeviceDiscoveryAgent *discoveryAgent;
+    QHash<QString, SeenAdvert> m_seenAdverts;
+    QTimer *m_scanCycleTimer = nullptr;
+    bool m_schedulerActive = false;
+    QDateTime m_boostUntil;
+    QDateTime m_pairedLastSeen;
 };
 
 #endif // BLEMANAGER_H
\ No newline at end of file
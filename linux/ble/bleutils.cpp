@@ -11,41 +11,107 @@ BLEUtils::BLEUtils(QObject *parent) : QObject(parent)
 {
 }
 
-bool BLEUtils::verifyRPA(const QString &address, const QByteArray &irk)
+void RpaVerifier::setIrk(const QByteArray &irk)
 {
-    if (address.isEmpty() || irk.isEmpty() || irk.size() != 16)
+    m_hasKey = false;
+    if (irk.size() != 16)
     {
-        return false;
+        return;
     }
 
-    // Split address into bytes and reverse order
-    QStringList parts = address.split(':');
-    if (parts.size() != 6)
+    // The E function feeds OpenSSL the key in reversed octet order; do the
+    // reversal and the key expansion once here instead of per advertisement
+    unsigned char reversedKey[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        reversedKey[i] = static_cast<unsigned char>(irk.at(15 - i));
+    }
+
+    m_hasKey = AES_set_encrypt_key(reversedKey, 128, &m_key) == 0;
+}
+
+bool RpaVerifier::verify(const quint8 (&rpa)[6]) const
+{
+    if (!m_hasKey)
     {
         return false;
     }
 
-    QByteArray rpa;
-    bool ok;
-    for (int i = parts.size() - 1; i >= 0; --i)
+    // ah(irk, prand) inlined against the cached key schedule: the padded
+    // prand, reversed for OpenSSL, puts the three random octets at the tail
+    // of the block, and the hash comes back in the last three output bytes
+    unsigned char in[16] = {0};
+    in[13] = rpa[5];
+    in[14] = rpa[4];
+    in[15] = rpa[3];
+
+    unsigned char out[16];
+    AES_encrypt(in, out, &m_key);
+
+    return rpa[0] == out[15] && rpa[1] == out[14] && rpa[2] == out[13];
+}
+
+bool RpaVerifier::verify(const QString &address) const
+{
+    quint8 rpa[6];
+    return parseAddress(address, rpa) && verify(rpa);
+}
+
+int RpaVerifier::firstMatch(const QStringList &addresses) const
+{
+    if (!m_hasKey)
     {
-        rpa.append(static_cast<char>(parts[i].toInt(&ok, 16)));
-        if (!ok)
+        return -1;
+    }
+
+    for (int i = 0; i < addresses.size(); ++i)
+    {
+        if (verify(addresses.at(i)))
         {
-            return false;
+            return i;
         }
     }
+    return -1;
+}
 
-    if (rpa.size() != 6)
+bool RpaVerifier::parseAddress(const QString &address, quint8 (&out)[6])
+{
+    // "AA:BB:CC:DD:EE:FF" parsed in place; no QString::split, no allocation
+    if (address.size() != 17)
     {
         return false;
     }
 
-    QByteArray prand = rpa.mid(3, 3);
-    QByteArray hash = rpa.left(3);
-    QByteArray computedHash = ah(irk, prand);
+    const auto nibble = [](QChar c) -> int {
+        if (c >= u'0' && c <= u'9') return c.unicode() - u'0';
+        if (c >= u'a' && c <= u'f') return c.unicode() - u'a' + 10;
+        if (c >= u'A' && c <= u'F') return c.unicode() - u'A' + 10;
+        return -1;
+    };
 
-    return hash == computedHash;
+    for (int i = 0; i < 6; ++i)
+    {
+        const int pos = i * 3;
+        if (i > 0 && address.at(pos - 1) != u':')
+        {
+            return false;
+        }
+        const int hi = nibble(address.at(pos));
+        const int lo = nibble(address.at(pos + 1));
+        if (hi < 0 || lo < 0)
+        {
+            return false;
+        }
+        // Reversed octet order: the last group of the string is out[0]
+        out[5 - i] = static_cast<quint8>((hi << 4) | lo);
+    }
+    return true;
+}
+
+bool BLEUtils::verifyRPA(const QString &address, const QByteArray &irk)
+{
+    const RpaVerifier verifier(irk);
+    return verifier.verify(address);
 }
 
 bool BLEUtils::isValidIrkRpa(const QByteArray &irk, const QString &rpa)
@@ -2,6 +2,64 @@
 
 #include <QObject>
 #include <QByteArray>
+#include <QStringList>
+#include <openssl/aes.h>
+
+/**
+ * @brief Verifies RPAs against a fixed IRK with a cached AES key schedule
+ *
+ * The IRK of a paired device never changes between pairings, so the AES-128
+ * key expansion is done once in setIrk() instead of on every advertisement.
+ * The hot path works on the 6-byte binary address and does not allocate.
+ */
+class RpaVerifier
+{
+public:
+    RpaVerifier() = default;
+    explicit RpaVerifier(const QByteArray &irk) { setIrk(irk); }
+
+    /**
+     * @brief Sets the IRK and computes its AES key schedule once
+     * @param irk The 16-byte Identity Resolving Key; an invalid key clears the verifier
+     */
+    void setIrk(const QByteArray &irk);
+
+    /**
+     * @brief Returns true if a valid IRK has been set
+     */
+    bool hasIrk() const { return m_hasKey; }
+
+    /**
+     * @brief Verifies a binary RPA, least-significant octet first
+     * @param rpa The 6-byte address in reversed (over-the-air) octet order
+     * @return true if the hash part matches ah(irk, prand)
+     */
+    bool verify(const quint8 (&rpa)[6]) const;
+
+    /**
+     * @brief Verifies a colon-separated address string such as "AA:BB:CC:DD:EE:FF"
+     */
+    bool verify(const QString &address) const;
+
+    /**
+     * @brief Verifies a scan burst of addresses with the cached key schedule
+     * @param addresses The addresses seen in one scan window
+     * @return The index of the first matching address, or -1 if none match
+     */
+    int firstMatch(const QStringList &addresses) const;
+
+    /**
+     * @brief Parses a colon-separated address into reversed binary form
+     * @param address The address string to parse
+     * @param out Receives the six octets, least-significant first
+     * @return true if the address was well-formed
+     */
+    static bool parseAddress(const QString &address, quint8 (&out)[6]);
+
+private:
+    AES_KEY m_key;
+    bool m_hasKey = false;
+};
 
 class BLEUtils : public QObject
 {
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <QObject>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <array>
+#include <functional>
+
+#include "logger.h"
+
+// Reconnect supervisor for the app's two outbound links: the AirPods AAP
+// socket and the phone relay socket. Each endpoint owns its own attempt
+// counter and retry timer — replacing the function-local static counter and
+// fixed 1500 ms singleShot the AirPods path used, and giving the phone path
+// retries at all. Delays back off exponentially with jitter so a transient
+// failure retries quickly while a dead link settles down, and the two
+// endpoints never fall into lockstep hammering the adapter.
+class ConnectionSupervisor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Endpoint
+    {
+        AirPods = 0,
+        Phone,
+        EndpointCount
+    };
+
+    using ConnectAction = std::function<void()>;
+
+    explicit ConnectionSupervisor(QObject *parent = nullptr) : QObject(parent)
+    {
+        for (int endpoint = 0; endpoint < EndpointCount; endpoint++)
+        {
+            State &state = m_states[endpoint];
+            state.timer = new QTimer(this);
+            state.timer->setSingleShot(true);
+            connect(state.timer, &QTimer::timeout, this, [this, endpoint]() {
+                if (m_states[endpoint].action)
+                {
+                    m_states[endpoint].action();
+                }
+            });
+        }
+    }
+
+    void setConnectAction(Endpoint endpoint, ConnectAction action)
+    {
+        m_states[endpoint].action = std::move(action);
+    }
+
+    // 0 means retry indefinitely (the delay still caps at MAX_DELAY_MS)
+    void setMaxAttempts(Endpoint endpoint, int attempts)
+    {
+        m_states[endpoint].maxAttempts = attempts;
+    }
+
+    // The link is up: clear the backoff state and any pending retry
+    void noteConnected(Endpoint endpoint)
+    {
+        State &state = m_states[endpoint];
+        state.attempts = 0;
+        state.timer->stop();
+    }
+
+    // A connection attempt just failed; schedule the next one with backoff
+    void scheduleRetry(Endpoint endpoint)
+    {
+        State &state = m_states[endpoint];
+        if (state.timer->isActive())
+        {
+            return; // A retry is already on its way
+        }
+        if (state.maxAttempts > 0 && state.attempts >= state.maxAttempts)
+        {
+            LOG_ERROR("Giving up on " << endpointName(endpoint) << " after "
+                                      << state.attempts << " attempts");
+            state.attempts = 0;
+            return;
+        }
+        state.attempts++;
+        const int delay = backoffDelayMs(state.attempts);
+        LOG_INFO("Retrying " << endpointName(endpoint) << " connection in " << delay
+                             << " ms (attempt " << state.attempts << ")");
+        state.timer->start(delay);
+    }
+
+    // External evidence the endpoint is reachable again (e.g. BlueZ reports
+    // the device connected): drop any pending backoff so the caller's
+    // immediate connect attempt starts from a clean slate
+    void cancelPendingRetry(Endpoint endpoint)
+    {
+        noteConnected(endpoint);
+    }
+
+private:
+    static constexpr int BASE_DELAY_MS = 500;
+    static constexpr int MAX_DELAY_MS = 15000;
+
+    struct State
+    {
+        QTimer *timer = nullptr;
+        ConnectAction action;
+        int attempts = 0;
+        int maxAttempts = 0;
+    };
+
+    static const char *endpointName(int endpoint)
+    {
+        return endpoint == AirPods ? "AirPods" : "phone";
+    }
+
+    // 500ms, 1s, 2s ... capped at 15s, each with +/-25% jitter so the two
+    // endpoints drift apart instead of retrying in lockstep
+    static int backoffDelayMs(int attempt)
+    {
+        const int shift = qMin(attempt - 1, 5);
+        int delay = qMin(BASE_DELAY_MS << shift, MAX_DELAY_MS);
+        const int jitter = delay / 4;
+        delay += QRandomGenerator::global()->bounded(-jitter, jitter + 1);
+        return delay;
+    }
+
+    std::array<State, EndpointCount> m_states;
+};
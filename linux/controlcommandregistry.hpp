@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QByteArray>
+#include <array>
+#include <functional>
+
+#include "BasicControlCommand.hpp"
+#include "logger.h"
+
+// Dense jump table over AAP control-command opcodes (the byte after the
+// shared ControlCommand header). All control packets enter through a single
+// dispatcher entry and are routed by one indexed load, so adding a command is
+// one registration line instead of a new branch in parseData plus a new
+// dispatcher handler.
+class ControlCommandRegistry
+{
+public:
+    using Handler = std::function<void(const QByteArray &)>;
+
+    // One-line registration for a BasicControlCommand toggle: parses the
+    // enabled/disabled state and forwards it to the receiver's setter. The
+    // receiver is produced by a callable evaluated at dispatch time, so the
+    // target can change between registration and dispatch (e.g. per-session
+    // DeviceInfo routing). The name only feeds the log line.
+    template <typename Command, typename Receiver, typename Provider>
+    void registerToggle(const char *name, Provider receiver, void (Receiver::*setter)(bool))
+    {
+        m_table[Command::ID] = [name, receiver, setter](const QByteArray &data)
+        {
+            if (auto value = Command::parseState(data))
+            {
+                (receiver()->*setter)(value.value());
+                LOG_INFO(name << " state received: " << value.value());
+            }
+        };
+    }
+
+    // Custom handler for opcodes whose payload is not a plain toggle.
+    void registerOpcode(quint8 opcode, Handler handler)
+    {
+        m_table[opcode] = std::move(handler);
+    }
+
+    // Routes a control packet by its opcode. Returns false when the opcode
+    // has no registered parser so the caller can log the miss.
+    bool dispatch(const QByteArray &data) const
+    {
+        if (data.size() <= 7) // Need at least the opcode and its value byte
+        {
+            return false;
+        }
+        const Handler &handler = m_table[static_cast<quint8>(data.at(6))];
+        if (!handler)
+        {
+            return false;
+        }
+        handler(data);
+        return true;
+    }
+
+private:
+    std::array<Handler, 256> m_table{};
+};
@@ -34,13 +34,28 @@ public:
         connect(getEarDetection(), &EarDetection::statusChanged, this, &DeviceInfo::primaryChanged);
     }
 
+    // Transactional updates: a packet's worth of setter calls between
+    // beginUpdate() and endUpdate() coalesces into one batched notification
+    // pass instead of a QML binding cascade per setter. Nestable.
+    void beginUpdate() { m_updateDepth++; }
+    void endUpdate()
+    {
+        if (m_updateDepth == 0 || --m_updateDepth > 0)
+        {
+            return;
+        }
+        const quint32 pending = m_pendingNotifies;
+        m_pendingNotifies = 0;
+        emitNotifies(pending);
+    }
+
     QString batteryStatus() const { return m_batteryStatus; }
     void setBatteryStatus(const QString &status)
     {
         if (m_batteryStatus != status)
         {
             m_batteryStatus = status;
-            emit batteryStatusChanged(status);
+            scheduleNotify(PendingBatteryStatus);
         }
     }
 
@@ -50,8 +65,7 @@ public:
         if (m_noiseControlMode != mode)
         {
             m_noiseControlMode = mode;
-            emit noiseControlModeChanged(mode);
-            emit noiseControlModeChangedInt(static_cast<int>(mode));
+            scheduleNotify(PendingNoiseControlMode);
         }
     }
     int noiseControlModeInt() const { return static_cast<int>(noiseControlMode()); }
@@ -63,7 +77,7 @@ public:
         if (m_conversationalAwareness != enabled)
         {
             m_conversationalAwareness = enabled;
-            emit conversationalAwarenessChanged(enabled);
+            scheduleNotify(PendingConversationalAwareness);
         }
     }
 
@@ -73,7 +87,7 @@ public:
         if (m_adaptiveNoiseLevel != level)
         {
             m_adaptiveNoiseLevel = level;
-            emit adaptiveNoiseLevelChanged(level);
+            scheduleNotify(PendingAdaptiveNoiseLevel);
         }
     }
 
@@ -83,7 +97,7 @@ public:
         if (m_deviceName != name)
         {
             m_deviceName = name;
-            emit deviceNameChanged(name);
+            scheduleNotify(PendingDeviceName);
         }
     }
 
@@ -95,7 +109,7 @@ public:
         if (m_oneBudANCMode != enabled)
         {
             m_oneBudANCMode = enabled;
-            emit oneBudANCModeChanged(enabled);
+            scheduleNotify(PendingOneBudANCMode);
         }
     }
 
@@ -105,12 +119,19 @@ public:
         if (m_model != model)
         {
             m_model = model;
-            emit modelChanged();
+            scheduleNotify(PendingModel);
         }
     }
 
     QByteArray magicAccIRK() const { return m_magicAccIRK; }
-    void setMagicAccIRK(const QByteArray &irk) { m_magicAccIRK = irk; }
+    void setMagicAccIRK(const QByteArray &irk)
+    {
+        if (m_magicAccIRK != irk)
+        {
+            m_magicAccIRK = irk;
+            scheduleNotify(PendingMagicAccIRK);
+        }
+    }
     QString magicAccIRKHex() const { return QString::fromUtf8(m_magicAccIRK.toHex()); }
 
     QByteArray magicAccEncKey() const { return m_magicAccEncKey; }
@@ -129,7 +150,7 @@ public:
         if (m_bluetoothAddress != address)
         {
             m_bluetoothAddress = address;
-            emit bluetoothAddressChanged(address);
+            scheduleNotify(PendingBluetoothAddress);
         }
     }
 
@@ -152,6 +173,7 @@ public:
 
     void reset()
     {
+        beginUpdate();
         setDeviceName("");
         setModel(AirPodsModel::Unknown);
         m_battery->reset();
@@ -159,6 +181,7 @@ public:
         setNoiseControlMode(NoiseControlMode::Off);
         setBluetoothAddress("");
         getEarDetection()->reset();
+        endUpdate();
     }
 
     void saveToSettings(QSettings &settings)
@@ -172,10 +195,12 @@ public:
     }
     void loadFromSettings(const QSettings &settings)
     {
+        beginUpdate();
         setDeviceName(settings.value("DeviceInfo/deviceName", "").toString());
         setModel(static_cast<AirPodsModel>(settings.value("DeviceInfo/model", (int)(AirPodsModel::Unknown)).toInt()));
         setMagicAccIRK(settings.value("DeviceInfo/magicAccIRK", QByteArray()).toByteArray());
         setMagicAccEncKey(settings.value("DeviceInfo/magicAccEncKey", QByteArray()).toByteArray());
+        endUpdate();
     }
 
     void updateBatteryStatus()
@@ -184,10 +209,14 @@ public:
         int rightLevel = getBattery()->getState(Battery::Component::Right).level;
         int caseLevel = getBattery()->getState(Battery::Component::Case).level;
         setBatteryStatus(QString("Left: %1%, Right: %2%, Case: %3%").arg(leftLevel).arg(rightLevel).arg(caseLevel));
+        // Numeric levels for consumers that would otherwise re-parse the
+        // display string (the tray icon in particular)
+        emit batteryLevelsChanged(leftLevel, rightLevel, caseLevel);
     }
 
 signals:
     void batteryStatusChanged(const QString &status);
+    void batteryLevelsChanged(int leftLevel, int rightLevel, int caseLevel);
     void noiseControlModeChanged(NoiseControlMode mode);
     void noiseControlModeChangedInt(int mode);
     void conversationalAwarenessChanged(bool enabled);
@@ -197,8 +226,55 @@ signals:
     void oneBudANCModeChanged(bool enabled);
     void modelChanged();
     void bluetoothAddressChanged(const QString &address);
+    void magicAccIRKChanged(const QByteArray &irk);
 
 private:
+    // One bit per deferred notification; emitted together at endUpdate()
+    enum PendingNotify : quint32
+    {
+        PendingBatteryStatus = 1 << 0,
+        PendingNoiseControlMode = 1 << 1,
+        PendingConversationalAwareness = 1 << 2,
+        PendingAdaptiveNoiseLevel = 1 << 3,
+        PendingDeviceName = 1 << 4,
+        PendingOneBudANCMode = 1 << 5,
+        PendingModel = 1 << 6,
+        PendingBluetoothAddress = 1 << 7,
+        PendingMagicAccIRK = 1 << 8,
+    };
+
+    void scheduleNotify(quint32 flag)
+    {
+        if (m_updateDepth > 0)
+        {
+            m_pendingNotifies |= flag;
+        }
+        else
+        {
+            emitNotifies(flag);
+        }
+    }
+
+    void emitNotifies(quint32 flags)
+    {
+        if (flags & PendingBatteryStatus) emit batteryStatusChanged(m_batteryStatus);
+        if (flags & PendingNoiseControlMode)
+        {
+            emit noiseControlModeChanged(m_noiseControlMode);
+            emit noiseControlModeChangedInt(static_cast<int>(m_noiseControlMode));
+        }
+        if (flags & PendingConversationalAwareness) emit conversationalAwarenessChanged(m_conversationalAwareness);
+        if (flags & PendingAdaptiveNoiseLevel) emit adaptiveNoiseLevelChanged(m_adaptiveNoiseLevel);
+        if (flags & PendingDeviceName) emit deviceNameChanged(m_deviceName);
+        if (flags & PendingOneBudANCMode) emit oneBudANCModeChanged(m_oneBudANCMode);
+        if (flags & PendingModel) emit modelChanged();
+        if (flags & PendingBluetoothAddress) emit bluetoothAddressChanged(m_bluetoothAddress);
+        if (flags & PendingMagicAccIRK) emit magicAccIRKChanged(m_magicAccIRK);
+    }
+
+    int m_updateDepth = 0;
+    quint32 m_pendingNotifies = 0;
+
     QString m_batteryStatus;
     NoiseControlMode m_noiseControlMode = NoiseControlMode::Transparency;
     bool m_conversationalAwareness = false;
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QBluetoothSocket>
+#include <QObject>
+#include <QString>
+
+#include "aapframer.hpp"
+#include "deviceinfo.hpp"
+#include "handshakecoordinator.hpp"
+#include "latencytracker.hpp"
+#include "telemetrystore.hpp"
+
+// One connected pair of AirPods: its L2CAP socket, its DeviceInfo (and
+// therefore Battery and EarDetection), and its own framer over the shared
+// parse pipeline. Sessions are created and multiplexed by SessionManager;
+// AirPodsTrayApp binds the tray and QML to whichever session is active.
+class DeviceSession : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString address READ address CONSTANT)
+    Q_PROPERTY(DeviceInfo *deviceInfo READ deviceInfo CONSTANT)
+
+public:
+    explicit DeviceSession(const QString &address, QObject *parent = nullptr)
+        : QObject(parent), m_address(address), m_deviceInfo(new DeviceInfo(this))
+    {
+        // Every battery and ear-detection edge lands in the telemetry log,
+        // whether or not this session is the active one
+        connect(m_deviceInfo->getBattery(), &Battery::batteryStatusChanged, this, [this]() {
+            TelemetryStore::instance().appendBattery(*m_deviceInfo->getBattery());
+        });
+        connect(m_deviceInfo->getEarDetection(), &EarDetection::statusChanged, this, [this]() {
+            TelemetryStore::instance().appendEar(*m_deviceInfo->getEarDetection());
+        });
+        m_handshake.setWriteSink([this](const QByteArray &packet) {
+            if (m_socket && m_socket->isOpen())
+            {
+                m_socket->write(packet);
+            }
+        });
+    }
+
+    QString address() const { return m_address; }
+
+    // The bootstrap session starts unbound; the first connect binds it
+    // instead of abandoning the DeviceInfo that settings were loaded into
+    void setAddress(const QString &address) { m_address = address; }
+    bool isBound() const { return !m_address.isEmpty(); }
+
+    DeviceInfo *deviceInfo() const { return m_deviceInfo; }
+    QBluetoothSocket *socket() const { return m_socket; }
+    AapFramer &framer() { return m_framer; }
+    HandshakeCoordinator &handshake() { return m_handshake; }
+
+    bool isConnected() const
+    {
+        return m_socket && m_socket->isOpen() &&
+               m_socket->state() == QBluetoothSocket::SocketState::ConnectedState;
+    }
+
+    // Takes ownership of a fresh socket, replacing (and deleting) any
+    // previous one; frames start flowing into this session's framer once the
+    // socket connects
+    void adoptSocket(QBluetoothSocket *socket)
+    {
+        if (m_socket)
+        {
+            m_socket->close();
+            m_socket->deleteLater();
+        }
+        m_socket = socket;
+        m_socket->setParent(this);
+        connect(m_socket, &QBluetoothSocket::connected, this, [this]() {
+            m_framer.reset();
+            connect(m_socket, &QBluetoothSocket::readyRead, this, [this]() {
+                LatencyTracker::instance().markArrival();
+                m_framer.drain(m_socket);
+            });
+        });
+    }
+
+    void closeSocket()
+    {
+        m_handshake.reset();
+        if (m_socket)
+        {
+            m_socket->close();
+            m_socket->deleteLater();
+            m_socket = nullptr;
+        }
+    }
+
+private:
+    QString m_address;
+    DeviceInfo *m_deviceInfo;
+    QBluetoothSocket *m_socket = nullptr;
+    AapFramer m_framer;
+    HandshakeCoordinator m_handshake;
+};
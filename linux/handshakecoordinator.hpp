@@ -0,0 +1,160 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <functional>
+
+#include "airpods_packets.h"
+#include "logger.h"
+#include "metricsregistry.hpp"
+
+// Connection handshake state machine. The old flow serialized every
+// round trip — HANDSHAKE, wait, SET_SPECIFIC_FEATURES, wait,
+// REQUEST_NOTIFICATIONS — and papered over dropped acks with a blind
+// 2-second timer, which lower-bounded connect-to-first-battery at the
+// full round-trip count. Here only the HANDSHAKE ack gates anything:
+// once it arrives the three independent requests (features,
+// notifications, magic keys) go out in one flight, outstanding replies
+// are tracked explicitly, and the retry timer re-sends exactly what is
+// still missing. Stage timings land in the metrics registry.
+class HandshakeCoordinator : public QObject
+{
+    Q_OBJECT
+
+public:
+    using WriteSink = std::function<void(const QByteArray &packet)>;
+
+    enum Pending
+    {
+        HandshakeAck = 0x01,
+        FeaturesAck = 0x02,
+        Metadata = 0x04,
+        MagicKeys = 0x08,
+        FirstBattery = 0x10
+    };
+
+    explicit HandshakeCoordinator(QObject *parent = nullptr) : QObject(parent)
+    {
+        m_retry.setSingleShot(true);
+        m_retry.setInterval(RETRY_MS);
+        connect(&m_retry, &QTimer::timeout, this, &HandshakeCoordinator::resendOutstanding);
+    }
+
+    void setWriteSink(WriteSink sink) { m_writeSink = std::move(sink); }
+
+    // Socket just connected: open with the handshake and start tracking
+    void begin()
+    {
+        m_clock.start();
+        m_attempts = 0;
+        m_outstanding = HandshakeAck;
+        LOG_INFO("Connected to device, sending initial packets");
+        m_writeSink(AirPodsPackets::Connection::HANDSHAKE);
+        m_retry.start();
+    }
+
+    // Socket dropped: stop retrying into the void
+    void reset()
+    {
+        m_outstanding = 0;
+        m_retry.stop();
+    }
+
+    // The only serializing ack: everything independent pipelines behind it
+    void onHandshakeAck()
+    {
+        if (!(m_outstanding & HandshakeAck))
+        {
+            return;
+        }
+        MetricsRegistry::instance().set(MetricsRegistry::HandshakeAckMs, m_clock.elapsed());
+        m_outstanding = FeaturesAck | Metadata | MagicKeys | FirstBattery;
+        m_attempts = 0;
+        sendOutstandingRequests();
+        m_retry.start();
+    }
+
+    void onFeaturesAck() { settle(FeaturesAck); }
+
+    void onMetadata()
+    {
+        if (m_outstanding & Metadata)
+        {
+            MetricsRegistry::instance().set(MetricsRegistry::FirstMetadataMs, m_clock.elapsed());
+        }
+        settle(Metadata);
+    }
+
+    void onMagicKeys() { settle(MagicKeys); }
+
+    void onBatteryStatus()
+    {
+        if (m_outstanding & FirstBattery)
+        {
+            MetricsRegistry::instance().set(MetricsRegistry::ConnectToBatteryMs, m_clock.elapsed());
+        }
+        settle(FirstBattery);
+    }
+
+private:
+    static constexpr int RETRY_MS = 750;
+    static constexpr int MAX_ATTEMPTS = 3;
+
+    void settle(Pending reply)
+    {
+        m_outstanding &= ~reply;
+        if (m_outstanding == 0)
+        {
+            m_retry.stop();
+        }
+    }
+
+    // One flight of every request whose reply is still outstanding
+    void sendOutstandingRequests()
+    {
+        if (m_outstanding & FeaturesAck)
+        {
+            m_writeSink(AirPodsPackets::Connection::SET_SPECIFIC_FEATURES);
+        }
+        if (m_outstanding & (Metadata | FirstBattery))
+        {
+            m_writeSink(AirPodsPackets::Connection::REQUEST_NOTIFICATIONS);
+        }
+        if (m_outstanding & MagicKeys)
+        {
+            m_writeSink(AirPodsPackets::MagicPairing::REQUEST_MAGIC_CLOUD_KEYS);
+        }
+    }
+
+    void resendOutstanding()
+    {
+        if (m_outstanding == 0)
+        {
+            return;
+        }
+        if (++m_attempts > MAX_ATTEMPTS)
+        {
+            LOG_WARN("Handshake gave up with outstanding replies: 0x" << Qt::hex << m_outstanding);
+            m_outstanding = 0;
+            return;
+        }
+        LOG_INFO("Re-sending handshake requests (attempt " << m_attempts << ", outstanding 0x"
+                                                           << Qt::hex << m_outstanding << ")");
+        if (m_outstanding & HandshakeAck)
+        {
+            m_writeSink(AirPodsPackets::Connection::HANDSHAKE);
+        }
+        else
+        {
+            sendOutstandingRequests();
+        }
+        m_retry.start();
+    }
+
+    WriteSink m_writeSink;
+    QTimer m_retry;
+    QElapsedTimer m_clock;
+    int m_outstanding = 0;
+    int m_attempts = 0;
+};
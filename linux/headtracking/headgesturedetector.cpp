@@ -0,0 +1,209 @@
+#include "headgesturedetector.h"
+
+namespace
+{
+    // Average of the filled prefix of a ring, or 0 when empty
+    template <typename Ring>
+    qint32 ringAverageAbs(const Ring &ring, int fill)
+    {
+        if (fill == 0)
+        {
+            return 0;
+        }
+        qint64 sum = 0;
+        for (int i = 0; i < fill; i++)
+        {
+            sum += qAbs(ring[i]);
+        }
+        return static_cast<qint32>(sum / fill);
+    }
+}
+
+void HeadGestureDetector::reset()
+{
+    m_horizontal = Axis{};
+    m_vertical = Axis{};
+    m_horizontal.direction = -1;
+    m_vertical.direction = -1;
+    m_intervalsMs = {};
+    m_intervalFill = 0;
+    m_intervalPos = 0;
+    m_lastExtremeMs = 0;
+}
+
+qint32 HeadGestureDetector::smooth(Axis &axis, qint32 sample)
+{
+    if (axis.windowFill == SMOOTH_WINDOW)
+    {
+        axis.windowSum -= axis.window[axis.windowPos];
+    }
+    else
+    {
+        axis.windowFill++;
+    }
+    axis.window[axis.windowPos] = sample;
+    axis.windowSum += sample;
+    axis.windowPos = (axis.windowPos + 1) % SMOOTH_WINDOW;
+    return axis.windowSum / axis.windowFill;
+}
+
+qint32 HeadGestureDetector::varianceOf(const Axis &axis) const
+{
+    if (axis.recentFill < 2)
+    {
+        return 0;
+    }
+    qint64 sum = 0;
+    for (int i = 0; i < axis.recentFill; i++)
+    {
+        sum += axis.recent[i];
+    }
+    const qint32 mean = static_cast<qint32>(sum / axis.recentFill);
+    qint64 squares = 0;
+    for (int i = 0; i < axis.recentFill; i++)
+    {
+        const qint64 delta = axis.recent[i] - mean;
+        squares += delta * delta;
+    }
+    return static_cast<qint32>(squares / (axis.recentFill - 1));
+}
+
+void HeadGestureDetector::trackExtremes(Axis &axis, qint32 smoothed, qint64 nowMs)
+{
+    // Isolation and variance state update on every sample
+    axis.recent[axis.recentPos] = smoothed;
+    axis.recentPos = (axis.recentPos + 1) % VARIANCE_WINDOW;
+    axis.recentFill = qMin(axis.recentFill + 1, VARIANCE_WINDOW);
+    axis.history[axis.historyPos] = smoothed;
+    axis.historyPos = (axis.historyPos + 1) % HISTORY_WINDOW;
+    axis.historyFill = qMin(axis.historyFill + 1, HISTORY_WINDOW);
+
+    if (!axis.hasPrevious)
+    {
+        axis.previous = smoothed;
+        axis.hasPrevious = true;
+        return;
+    }
+
+    const qint32 previous = axis.previous;
+    axis.previous = smoothed;
+
+    if (axis.direction < 0)
+    {
+        axis.direction = smoothed > previous ? 1 : 0;
+        return;
+    }
+
+    // The direction-change threshold adapts to how violently the axis is
+    // moving, clamped to the prototype's fixed band
+    const qint32 threshold = qBound(MIN_DIRECTION_THRESHOLD,
+                                    varianceOf(axis) / 3,
+                                    DIRECTION_CHANGE_THRESHOLD);
+
+    const bool turnedDown = axis.direction == 1 && smoothed < previous - threshold;
+    const bool turnedUp = axis.direction == 0 && smoothed > previous + threshold;
+    if (!turnedDown && !turnedUp)
+    {
+        return;
+    }
+    axis.direction = turnedUp ? 1 : 0;
+
+    // Only swings past the amplitude floor count as deliberate motion
+    if (qAbs(previous) <= PEAK_THRESHOLD)
+    {
+        return;
+    }
+
+    axis.extremes[axis.extremePos] = previous;
+    axis.extremePos = (axis.extremePos + 1) % EXTREME_WINDOW;
+    axis.extremeFill = qMin(axis.extremeFill + 1, EXTREME_WINDOW);
+
+    if (m_lastExtremeMs > 0)
+    {
+        m_intervalsMs[m_intervalPos] = static_cast<qint32>(nowMs - m_lastExtremeMs);
+        m_intervalPos = (m_intervalPos + 1) % INTERVAL_WINDOW;
+        m_intervalFill = qMin(m_intervalFill + 1, INTERVAL_WINDOW);
+    }
+    m_lastExtremeMs = nowMs;
+}
+
+int HeadGestureDetector::rhythmConsistencyPerMille() const
+{
+    if (m_intervalFill < 2)
+    {
+        return 0;
+    }
+    qint64 sum = 0;
+    for (int i = 0; i < m_intervalFill; i++)
+    {
+        sum += m_intervalsMs[i];
+    }
+    const qint64 mean = sum / m_intervalFill;
+    if (mean == 0)
+    {
+        return 0;
+    }
+
+    // Mean squared relative deviation of the intervals, scaled against the
+    // prototype's 0.5 consistency band: perfectly even nodding scores 1000
+    qint64 squares = 0;
+    for (int i = 0; i < m_intervalFill; i++)
+    {
+        const qint64 relative = m_intervalsMs[i] * 1000 / mean - 1000; // per-mille deviation
+        squares += relative * relative / 1000;
+    }
+    const qint64 meanSquare = squares / m_intervalFill;
+    return static_cast<int>(qMax<qint64>(0, 1000 - qMin<qint64>(1000, meanSquare * 2)));
+}
+
+int HeadGestureDetector::confidencePerMille(const Axis &axis, const Axis &other) const
+{
+    if (axis.extremeFill < REQUIRED_EXTREMES)
+    {
+        return 0;
+    }
+
+    const qint32 averageAmplitude = ringAverageAbs(axis.extremes, axis.extremeFill);
+    const int amplitudePm = static_cast<int>(
+        qMin<qint64>(1000, qint64(averageAmplitude) * 1000 / AMPLITUDE_FULL_SCALE));
+
+    const int rhythmPm = rhythmConsistencyPerMille();
+
+    // Deliberate gestures swing through zero: consecutive extremes should
+    // alternate sign
+    bool alternating = true;
+    for (int i = 1; i < axis.extremeFill; i++)
+    {
+        if ((axis.extremes[i] > 0) == (axis.extremes[i - 1] > 0))
+        {
+            alternating = false;
+            break;
+        }
+    }
+    const int alternationPm = alternating ? 1000 : 500;
+
+    // A nod should live on the vertical axis: compare this axis's extreme
+    // amplitude against the other axis's recent motion
+    const qint32 otherAmplitude = ringAverageAbs(other.history, other.historyFill);
+    const int isolationPm = static_cast<int>(
+        qMin<qint64>(1000, qint64(averageAmplitude) * 1200 / (otherAmplitude + 1)));
+
+    return (amplitudePm * 400 + rhythmPm * 200 + alternationPm * 200 + isolationPm * 200) / 1000;
+}
+
+HeadGestureDetector::Gesture HeadGestureDetector::feed(qint16 horizontal, qint16 vertical, qint64 nowMs)
+{
+    trackExtremes(m_horizontal, smooth(m_horizontal, horizontal), nowMs);
+    trackExtremes(m_vertical, smooth(m_vertical, vertical), nowMs);
+
+    // Vertical wins ties, matching the prototype's check order
+    if (confidencePerMille(m_vertical, m_horizontal) >= CONFIDENCE_THRESHOLD_PM)
+    {
+        return Gesture::Nod;
+    }
+    if (confidencePerMille(m_horizontal, m_vertical) >= CONFIDENCE_THRESHOLD_PM)
+    {
+        return Gesture::Shake;
+    }
+    return Gesture::None;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QtGlobal>
+#include <array>
+
+// Port of the Python prototype's gesture recognizer (head-tracking/
+// gestures.py) in pure integer math. Samples are the two signed 16-bit
+// orientation values from the sensor stream; the detector smooths them,
+// tracks direction-change extremes per axis and scores amplitude, rhythm,
+// alternation and axis isolation to decide between a nod (yes) and a shake
+// (no). All factors are per-mille integers — no floating point and no
+// allocation on the feed path, so the worker keeps up with the packet rate
+// the prototype dropped frames at.
+class HeadGestureDetector
+{
+public:
+    enum class Gesture
+    {
+        None,
+        Nod,  // Vertical: head moves up and down ("yes")
+        Shake // Horizontal: head moves left and right ("no")
+    };
+
+    HeadGestureDetector() { reset(); }
+
+    // Drops all buffered motion state, ready for a fresh detection run
+    void reset();
+
+    // Feeds one orientation sample; returns the recognized gesture or
+    // Gesture::None. nowMs only needs to be monotonic.
+    Gesture feed(qint16 horizontal, qint16 vertical, qint64 nowMs);
+
+private:
+    static constexpr int SMOOTH_WINDOW = 5;
+    static constexpr int VARIANCE_WINDOW = 4;
+    static constexpr int HISTORY_WINDOW = 8;
+    static constexpr int EXTREME_WINDOW = 4;
+    static constexpr int INTERVAL_WINDOW = 5;
+
+    static constexpr qint32 PEAK_THRESHOLD = 400;
+    static constexpr qint32 DIRECTION_CHANGE_THRESHOLD = 175;
+    static constexpr qint32 MIN_DIRECTION_THRESHOLD = 100;
+    static constexpr int REQUIRED_EXTREMES = 3;
+    static constexpr qint32 AMPLITUDE_FULL_SCALE = 600;
+    static constexpr int CONFIDENCE_THRESHOLD_PM = 700; // 0.7 in per-mille
+
+    struct Axis
+    {
+        // Moving-average smoothing window
+        std::array<qint32, SMOOTH_WINDOW> window;
+        qint32 windowSum;
+        int windowFill;
+        int windowPos;
+
+        // Recent smoothed samples feeding the dynamic threshold variance
+        std::array<qint32, VARIANCE_WINDOW> recent;
+        int recentFill;
+        int recentPos;
+
+        // Smoothed magnitudes for the cross-axis isolation factor
+        std::array<qint32, HISTORY_WINDOW> history;
+        int historyFill;
+        int historyPos;
+
+        // Direction-change extremes, chronological
+        std::array<qint32, EXTREME_WINDOW> extremes;
+        int extremeFill;
+        int extremePos;
+
+        qint32 previous;
+        bool hasPrevious;
+        int direction; // -1 unknown, 0 falling, 1 rising
+    };
+
+    qint32 smooth(Axis &axis, qint32 sample);
+    qint32 varianceOf(const Axis &axis) const;
+    void trackExtremes(Axis &axis, qint32 smoothed, qint64 nowMs);
+    int rhythmConsistencyPerMille() const;
+    int confidencePerMille(const Axis &axis, const Axis &other) const;
+
+    Axis m_horizontal;
+    Axis m_vertical;
+
+    // Intervals between consecutive extremes, for rhythm scoring
+    std::array<qint32, INTERVAL_WINDOW> m_intervalsMs;
+    int m_intervalFill;
+    int m_intervalPos;
+    qint64 m_lastExtremeMs;
+};
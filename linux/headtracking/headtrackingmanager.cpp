@@ -0,0 +1,80 @@
+#include "headtrackingmanager.h"
+
+#include "airpods_packets.h"
+#include "logger.h"
+
+void HeadTrackingManager::startDetection()
+{
+    if (m_detecting)
+    {
+        return;
+    }
+    if (!m_writeSink || !m_writeSink(AirPodsPackets::HeadTracking::START))
+    {
+        LOG_WARN("Cannot start head tracking: no connected device");
+        return;
+    }
+
+    LOG_INFO("Head gesture detection started");
+    m_worker->beginRun();
+    m_detecting = true;
+    m_timeout.start();
+    emit detectingChanged(true);
+}
+
+void HeadTrackingManager::stopDetection()
+{
+    if (!m_detecting)
+    {
+        return;
+    }
+    m_worker->endRun();
+    finishRun();
+}
+
+void HeadTrackingManager::onGestureDetected(int gesture)
+{
+    if (!m_detecting)
+    {
+        return; // Timed out or stopped while the worker was scoring
+    }
+    finishRun();
+
+    switch (static_cast<HeadGestureDetector::Gesture>(gesture))
+    {
+    case HeadGestureDetector::Gesture::Nod:
+        LOG_INFO("Head gesture detected: nod");
+        emit nodDetected();
+        break;
+    case HeadGestureDetector::Gesture::Shake:
+        LOG_INFO("Head gesture detected: shake");
+        emit shakeDetected();
+        break;
+    default:
+        break;
+    }
+}
+
+void HeadTrackingManager::onDetectionTimeout()
+{
+    if (!m_detecting)
+    {
+        return;
+    }
+    LOG_WARN("Head gesture detection timed out");
+    m_worker->endRun();
+    finishRun();
+    emit detectionTimedOut();
+}
+
+// Shared teardown: stop the sensor stream and leave detection idle
+void HeadTrackingManager::finishRun()
+{
+    m_timeout.stop();
+    m_detecting = false;
+    if (m_writeSink)
+    {
+        m_writeSink(AirPodsPackets::HeadTracking::STOP);
+    }
+    emit detectingChanged(false);
+}
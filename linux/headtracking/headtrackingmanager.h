@@ -0,0 +1,173 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSemaphore>
+#include <QThread>
+#include <QTimer>
+#include <atomic>
+#include <functional>
+
+#include "headgesturedetector.h"
+#include "spscring.hpp"
+
+struct OrientationSample
+{
+    qint16 horizontal;
+    qint16 vertical;
+    qint64 timestampMs;
+};
+
+// Worker thread running the gesture detector. Samples arrive through the
+// lock-free ring; the semaphore only parks the thread when the stream goes
+// quiet, so the steady state is one release/acquire pair per packet and
+// the math never runs on the GUI thread.
+class GestureWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit GestureWorker(SpscRing<OrientationSample, 256> &ring, QObject *parent = nullptr)
+        : QThread(parent), m_ring(ring)
+    {
+    }
+
+    void wake() { m_available.release(); }
+
+    void beginRun()
+    {
+        m_detector.reset();
+        m_active.store(true, std::memory_order_release);
+    }
+
+    void endRun() { m_active.store(false, std::memory_order_release); }
+
+    void shutdown()
+    {
+        m_running.store(false, std::memory_order_release);
+        m_available.release();
+        wait();
+    }
+
+signals:
+    void gestureDetected(int gesture);
+
+protected:
+    void run() override
+    {
+        while (m_running.load(std::memory_order_acquire))
+        {
+            m_available.acquire();
+            OrientationSample sample;
+            while (m_ring.tryPop(sample))
+            {
+                if (!m_active.load(std::memory_order_acquire))
+                {
+                    continue; // Drain stale samples without scoring them
+                }
+                const auto gesture = m_detector.feed(sample.horizontal, sample.vertical, sample.timestampMs);
+                if (gesture != HeadGestureDetector::Gesture::None)
+                {
+                    m_active.store(false, std::memory_order_release);
+                    emit gestureDetected(static_cast<int>(gesture));
+                }
+            }
+        }
+    }
+
+private:
+    SpscRing<OrientationSample, 256> &m_ring;
+    QSemaphore m_available;
+    HeadGestureDetector m_detector;
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_active{false};
+};
+
+// Native replacement for the Python head-tracking prototype: owns the
+// gesture worker, turns the sensor stream on and off over the existing AAP
+// socket, and surfaces nod/shake results as signals on the GUI thread.
+// pushSample is called from the packet dispatcher's head-tracking handler
+// and does nothing but a ring push and a semaphore release.
+class HeadTrackingManager : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool detecting READ isDetecting NOTIFY detectingChanged)
+
+public:
+    // Sends an AAP packet to the connected device; wired to
+    // writePacketToSocket by the owner
+    using WriteSink = std::function<bool(const QByteArray &packet)>;
+
+    explicit HeadTrackingManager(QObject *parent = nullptr) : QObject(parent)
+    {
+        m_worker = new GestureWorker(m_ring, this);
+        connect(m_worker, &GestureWorker::gestureDetected, this, &HeadTrackingManager::onGestureDetected);
+        m_worker->start();
+
+        m_timeout.setSingleShot(true);
+        m_timeout.setInterval(DETECTION_TIMEOUT_MS);
+        connect(&m_timeout, &QTimer::timeout, this, &HeadTrackingManager::onDetectionTimeout);
+
+        m_clock.start();
+    }
+
+    ~HeadTrackingManager() override { m_worker->shutdown(); }
+
+    void setWriteSink(WriteSink sink) { m_writeSink = std::move(sink); }
+
+    bool isDetecting() const { return m_detecting; }
+
+    // Hot path: the stream stage enqueues a drain's worth of samples and
+    // wakes the worker once per batch. A full ring drops the sample — a
+    // fresher one is right behind it.
+    void enqueueSample(qint16 horizontal, qint16 vertical)
+    {
+        if (!m_detecting)
+        {
+            return;
+        }
+        m_ring.tryPush({horizontal, vertical, m_clock.elapsed()});
+    }
+
+    void wakeWorker()
+    {
+        if (m_detecting)
+        {
+            m_worker->wake();
+        }
+    }
+
+    void pushSample(qint16 horizontal, qint16 vertical)
+    {
+        enqueueSample(horizontal, vertical);
+        wakeWorker();
+    }
+
+public slots:
+    // Starts the sensor stream and a single detection run; the run ends on
+    // the first recognized gesture or the timeout
+    void startDetection();
+    void stopDetection();
+
+signals:
+    void nodDetected();
+    void shakeDetected();
+    void detectionTimedOut();
+    void detectingChanged(bool detecting);
+
+private slots:
+    void onGestureDetected(int gesture);
+    void onDetectionTimeout();
+
+private:
+    static constexpr int DETECTION_TIMEOUT_MS = 15000;
+
+    void finishRun();
+
+    SpscRing<OrientationSample, 256> m_ring;
+    GestureWorker *m_worker = nullptr;
+    WriteSink m_writeSink;
+    QTimer m_timeout;
+    QElapsedTimer m_clock;
+    bool m_detecting = false;
+};
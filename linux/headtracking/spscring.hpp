@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+// Fixed-capacity single-producer single-consumer ring buffer. The GUI
+// thread pushes orientation samples as they fall out of the packet
+// dispatcher and the gesture worker pops them, with one release store on
+// each side and no locks — the sensor stream must never stall the socket
+// read path. Capacity must be a power of two so the index wrap is a mask.
+template <typename T, quint32 Capacity>
+class SpscRing
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Returns false when the ring is full; the producer drops the sample
+    // rather than blocking (a fresher one is already on the way)
+    bool tryPush(const T &value)
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        const quint32 tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail == Capacity)
+        {
+            return false;
+        }
+        m_slots[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns false when the ring is empty
+    bool tryPop(T &out)
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        const quint32 head = m_head.load(std::memory_order_acquire);
+        if (head == tail)
+        {
+            return false;
+        }
+        out = m_slots[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> m_slots;
+    std::atomic<quint32> m_head{0};
+    std::atomic<quint32> m_tail{0};
+};
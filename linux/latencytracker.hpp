@@ -0,0 +1,170 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief End-to-end latency timeline for the packet-to-UI pipeline
+ *
+ * The whole path from the socket's readyRead through parseData, the state
+ * setters and the tray refresh runs synchronously on the GUI thread over
+ * direct connections, so a single set of plain timestamp slots is enough:
+ * no packet is ever in flight on two threads at once. Histogram buckets are
+ * preallocated power-of-two microsecond ranges, so recording a sample is a
+ * handful of stores with no allocation and no locking on the hot path.
+ *
+ * Stages: Arrival is stamped in the readyRead lambda before the framer
+ * drains the socket (one drain can carry several frames; they share the
+ * arrival stamp), Parsed at dispatch entry, StateApplied once the parsed
+ * values hit DeviceInfo, and UiUpdated when TrayIconManager has redrawn.
+ */
+class LatencyTracker
+{
+public:
+    enum Stage
+    {
+        Arrival = 0,
+        Parsed,
+        StateApplied,
+        UiUpdated,
+        StageCount
+    };
+
+    static LatencyTracker &instance()
+    {
+        static LatencyTracker tracker;
+        return tracker;
+    }
+
+    // Called from the readyRead lambda, before the framer drains the socket
+    void markArrival()
+    {
+        m_marks[Arrival] = m_clock.nsecsElapsed();
+        m_marks[Parsed] = 0;
+        m_marks[StateApplied] = 0;
+        m_marks[UiUpdated] = 0;
+    }
+
+    // Called at parseData entry; the type byte keys the per-packet histogram
+    void beginFrame(quint8 packetType)
+    {
+        m_packetType = packetType;
+        m_marks[Parsed] = m_clock.nsecsElapsed();
+    }
+
+    void mark(Stage stage)
+    {
+        m_marks[stage] = m_clock.nsecsElapsed();
+    }
+
+    // Called after dispatch returns; folds whatever stages this frame
+    // reached into the histograms and clears the timeline for the next one
+    void completeFrame()
+    {
+        const qint64 arrival = m_marks[Arrival];
+        if (arrival == 0)
+        {
+            return; // frame outside a tracked drain (e.g. replayed data)
+        }
+
+        qint64 last = arrival;
+        for (int stage = Parsed; stage < StageCount; stage++)
+        {
+            const qint64 at = m_marks[stage];
+            if (at == 0)
+            {
+                continue;
+            }
+            m_stageHistograms[stage][bucketFor(at - last)]++;
+            last = at;
+            m_marks[stage] = 0;
+        }
+
+        PacketStats &stats = m_packets[m_packetType];
+        stats.count++;
+        stats.totalNs += last - arrival;
+        stats.histogram[bucketFor(last - arrival)]++;
+    }
+
+    // Human-readable dump of everything collected so far; cheap enough to
+    // run from the tray menu while the pipeline keeps recording
+    QString report() const
+    {
+        QString out = QStringLiteral("Packet-to-UI latency report\n");
+        static const char *stageNames[StageCount] = {
+            "arrival", "arrival->parsed", "parsed->state", "state->ui"};
+
+        for (int stage = Parsed; stage < StageCount; stage++)
+        {
+            out += QStringLiteral("  stage %1: %2\n")
+                       .arg(QLatin1String(stageNames[stage]),
+                            describeHistogram(m_stageHistograms[stage]));
+        }
+
+        for (int type = 0; type < 256; type++)
+        {
+            const PacketStats &stats = m_packets[type];
+            if (stats.count == 0)
+            {
+                continue;
+            }
+            out += QStringLiteral("  packet 0x%1: %2 frames, avg %3 us, %4\n")
+                       .arg(type, 2, 16, QLatin1Char('0'))
+                       .arg(stats.count)
+                       .arg(stats.totalNs / stats.count / 1000)
+                       .arg(describeHistogram(stats.histogram));
+        }
+        return out;
+    }
+
+private:
+    static constexpr int BUCKET_COUNT = 24; // 1us .. ~8s in power-of-two steps
+
+    struct PacketStats
+    {
+        quint64 count = 0;
+        qint64 totalNs = 0;
+        std::array<quint32, BUCKET_COUNT> histogram{};
+    };
+
+    LatencyTracker() { m_clock.start(); }
+
+    // Bucket i holds samples in [2^i, 2^(i+1)) microseconds
+    static int bucketFor(qint64 ns)
+    {
+        qint64 us = ns / 1000;
+        int bucket = 0;
+        while (us > 1 && bucket < BUCKET_COUNT - 1)
+        {
+            us >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    static QString describeHistogram(const std::array<quint32, BUCKET_COUNT> &histogram)
+    {
+        QString out;
+        for (int bucket = 0; bucket < BUCKET_COUNT; bucket++)
+        {
+            if (histogram[bucket] == 0)
+            {
+                continue;
+            }
+            if (!out.isEmpty())
+            {
+                out += QLatin1String(", ");
+            }
+            out += QStringLiteral("<%1us: %2").arg(2LL << bucket).arg(histogram[bucket]);
+        }
+        return out.isEmpty() ? QStringLiteral("no samples") : out;
+    }
+
+    QElapsedTimer m_clock;
+    std::array<qint64, StageCount> m_marks{};
+    quint8 m_packetType = 0;
+    std::array<std::array<quint32, BUCKET_COUNT>, StageCount> m_stageHistograms{};
+    std::array<PacketStats, 256> m_packets{};
+};
@@ -5,7 +5,27 @@
 
 Q_DECLARE_LOGGING_CATEGORY(Librepods)
 
-#define LOG_INFO(msg) qCInfo(Librepods) << "\033[32m" << msg << "\033[0m"
-#define LOG_WARN(msg) qCWarning(Librepods) << "\033[33m" << msg << "\033[0m"
-#define LOG_ERROR(msg) qCCritical(Librepods) << "\033[31m" << msg << "\033[0m"
-#define LOG_DEBUG(msg) qCDebug(Librepods) << "\033[34m" << msg << "\033[0m"
+// The explicit enabled-check guarantees the streamed arguments (hex dumps,
+// string formatting) are never evaluated when the level is filtered out,
+// regardless of how the qC* macros expand. Enabled output is handed to the
+// asynchronous sink (see asynclogsink.hpp) so I/O happens off this thread.
+#define LOG_INFO(msg) \
+    do { \
+        if (Librepods().isInfoEnabled()) \
+            qCInfo(Librepods) << "\033[32m" << msg << "\033[0m"; \
+    } while (0)
+#define LOG_WARN(msg) \
+    do { \
+        if (Librepods().isWarningEnabled()) \
+            qCWarning(Librepods) << "\033[33m" << msg << "\033[0m"; \
+    } while (0)
+#define LOG_ERROR(msg) \
+    do { \
+        if (Librepods().isCriticalEnabled()) \
+            qCCritical(Librepods) << "\033[31m" << msg << "\033[0m"; \
+    } while (0)
+#define LOG_DEBUG(msg) \
+    do { \
+        if (Librepods().isDebugEnabled()) \
+            qCDebug(Librepods) << "\033[34m" << msg << "\033[0m"; \
+    } while (0)
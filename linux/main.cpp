@@ -1,4 +1,7 @@
 #include <QSettings>
+#include <QSharedMemory>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QLocalServer>
 #include <QLocalSocket>
 #include <QApplication>
@@ -15,6 +18,7 @@
 
 #include "airpods_packets.h"
 #include "logger.h"
+#include "asynclogsink.hpp"
 #include "media/mediacontroller.h"
 #include "trayiconmanager.h"
 #include "enums.h"
@@ -26,6 +30,18 @@
 #include "ble/bleutils.h"
 #include "QRCodeImageProvider.hpp"
 #include "systemsleepmonitor.hpp"
+#include "packetdispatcher.hpp"
+#include "controlcommandregistry.hpp"
+#include "devicesession.hpp"
+#include "sessionmanager.hpp"
+#include "headtracking/headtrackingmanager.h"
+#include "streamstage.hpp"
+#include "telemetrystore.hpp"
+#include "settingsstore.hpp"
+#include "latencytracker.hpp"
+#include "metricsregistry.hpp"
+#include "phonerelayqueue.hpp"
+#include "connectionsupervisor.hpp"
 
 using namespace AirpodsTrayApp::Enums;
 
@@ -40,19 +56,26 @@ class AirPodsTrayApp : public QObject {
     Q_PROPERTY(bool notificationsEnabled READ notificationsEnabled WRITE setNotificationsEnabled NOTIFY notificationsEnabledChanged)
     Q_PROPERTY(int retryAttempts READ retryAttempts WRITE setRetryAttempts NOTIFY retryAttemptsChanged)
     Q_PROPERTY(bool hideOnStart READ hideOnStart CONSTANT)
-    Q_PROPERTY(DeviceInfo *deviceInfo READ deviceInfo CONSTANT)
+    Q_PROPERTY(DeviceInfo *deviceInfo READ deviceInfo NOTIFY deviceInfoChanged)
+    Q_PROPERTY(SessionManager *sessions READ sessionManager CONSTANT)
+    Q_PROPERTY(HeadTrackingManager *headTracking READ headTracking CONSTANT)
+    Q_PROPERTY(TelemetryStore *telemetry READ telemetry CONSTANT)
     Q_PROPERTY(QString phoneMacStatus READ phoneMacStatus NOTIFY phoneMacStatusChanged)
 
 public:
     AirPodsTrayApp(bool debugMode, bool hideOnStart, QQmlApplicationEngine *parent = nullptr)
         : QObject(parent), debugMode(debugMode), m_settings(new QSettings("AirPodsTrayApp", "AirPodsTrayApp"))
         , m_autoStartManager(new AutoStartManager(this)), m_hideOnStart(hideOnStart), parent(parent)
-        , m_deviceInfo(new DeviceInfo(this)), m_bleManager(new BleManager(this))
+        , m_bleManager(new BleManager(this))
         , m_systemSleepMonitor(new SystemSleepMonitor(this))
     {
         QLoggingCategory::setFilterRules(QString("Librepods.debug=%1").arg(debugMode ? "true" : "false"));
         LOG_INFO("Initializing AirPodsTrayApp");
 
+        // Settings writes debounce onto a background writer; reads at
+        // startup still come straight from m_settings
+        m_settingsStore = new SettingsStore(this);
+
         // Initialize tray icon and connect signals
         trayManager = new TrayIconManager(this);
         trayManager->setNotificationsEnabled(loadNotificationsEnabled());
@@ -61,9 +84,9 @@ public:
         connect(trayManager, &TrayIconManager::openSettings, this, &AirPodsTrayApp::onOpenSettings);
         connect(trayManager, &TrayIconManager::noiseControlChanged, this, &AirPodsTrayApp::setNoiseControlMode);
         connect(trayManager, &TrayIconManager::conversationalAwarenessToggled, this, &AirPodsTrayApp::setConversationalAwareness);
-        connect(m_deviceInfo, &DeviceInfo::batteryStatusChanged, trayManager, &TrayIconManager::updateBatteryStatus);
-        connect(m_deviceInfo, &DeviceInfo::noiseControlModeChanged, trayManager, &TrayIconManager::updateNoiseControlState);
-        connect(m_deviceInfo, &DeviceInfo::conversationalAwarenessChanged, trayManager, &TrayIconManager::updateConversationalAwareness);
+        connect(trayManager, &TrayIconManager::latencyReportRequested, this, []() {
+            LOG_INFO(LatencyTracker::instance().report());
+        });
         connect(trayManager, &TrayIconManager::notificationsEnabledChanged, this, &AirPodsTrayApp::saveNotificationsEnabled);
         connect(trayManager, &TrayIconManager::notificationsEnabledChanged, this, &AirPodsTrayApp::notificationsEnabledChanged);
 
@@ -72,12 +95,78 @@ public:
         connect(mediaController, &MediaController::mediaStateChanged, this, &AirPodsTrayApp::handleMediaStateChange);
         mediaController->followMediaChanges();
 
+        // Native head tracking: the manager turns the sensor stream on and
+        // off over the AAP socket and scores gestures off the GUI thread
+        m_headTracking = new HeadTrackingManager(this);
+        m_headTracking->setWriteSink([this](const QByteArray &packet) {
+            return writePacketToSocket(packet, "Head tracking packet written: ");
+        });
+
+        registerPacketHandlers();
+
+        // Phone relay goes through a coalescing bounded queue instead of one
+        // allocation and write per packet (see phonerelayqueue.hpp)
+        m_phoneRelay = new PhoneRelayQueue(this);
+        m_phoneRelay->setAvailableProbe([this]() { return phoneSocket && phoneSocket->isOpen(); });
+        m_phoneRelay->setWriteSink([this](const QByteArray &payload) { return phoneSocket->write(payload); });
+        m_phoneRelay->setReconnectRequest([this]() {
+            LOG_WARN("Phone socket is not open, attempting reconnect");
+            m_connectionSupervisor->scheduleRetry(ConnectionSupervisor::Phone);
+        });
+
+        // Both sockets reconnect through the supervisor's per-endpoint
+        // backoff instead of ad-hoc fixed-delay timers
+        m_connectionSupervisor = new ConnectionSupervisor(this);
+        m_connectionSupervisor->setMaxAttempts(ConnectionSupervisor::AirPods, m_retryAttempts);
+        m_connectionSupervisor->setConnectAction(ConnectionSupervisor::AirPods, [this]() {
+            MetricsRegistry::instance().add(MetricsRegistry::ReconnectAttempts);
+            connectToDevice(m_lastAirPodsDevice);
+        });
+        m_connectionSupervisor->setConnectAction(ConnectionSupervisor::Phone, [this]() {
+            MetricsRegistry::instance().add(MetricsRegistry::ReconnectAttempts);
+            connectToPhone();
+        });
+
+        // All device sessions multiplex through one parse pipeline: each
+        // session's framer cuts frames out of its L2CAP stream using the
+        // dispatcher's known frame sizes and feeds them here tagged with the
+        // originating session, so state lands on that session's DeviceInfo.
+        m_sessionManager = new SessionManager(this);
+        m_sessionManager->setLengthProbe([this](const QByteArray &frame)
+                                         {
+            const int streamSize = m_streamStage.expectedSize(frame);
+            return streamSize != -1 ? streamSize : m_packetDispatcher.expectedSize(frame); });
+        m_sessionManager->setFrameSink([this](DeviceSession *session, const QByteArray &frame)
+                                       {
+            parseData(session, frame);
+            relayPacketToPhone(frame); });
+        // One flush per socket drain delivers each stream's batch downstream
+        m_sessionManager->setBatchEnd([this]() { m_streamStage.flush(); });
+        connect(m_sessionManager, &SessionManager::activeSessionChanged, this, &AirPodsTrayApp::bindActiveSession);
+        // The bootstrap session exists before any device does, so settings
+        // load into a DeviceInfo and the first connect binds it to an
+        // address; becoming active binds the tray and QML to it
+        m_sessionManager->ensureSession(QString());
+
         monitor = new BluetoothMonitor(this);
         connect(monitor, &BluetoothMonitor::deviceConnected, this, &AirPodsTrayApp::bluezDeviceConnected);
         connect(monitor, &BluetoothMonitor::deviceDisconnected, this, &AirPodsTrayApp::bluezDeviceDisconnected);
+        // Completion of the async BlueZ Connect drives the rest of the handoff
+        connect(monitor, &BluetoothMonitor::connectFinished, this, [this](const QString &address, bool success, const QString &error) {
+            if (!success) {
+                LOG_WARN("BlueZ Connect failed for " << address << ": " << error);
+            }
+            connectToAirPods(false);
+        });
+        connect(monitor, &BluetoothMonitor::disconnectFinished, this, [](const QString &address, bool success, const QString &error) {
+            if (success) {
+                LOG_INFO("BlueZ Disconnect completed for " << address);
+            } else {
+                LOG_WARN("BlueZ Disconnect failed for " << address << ": " << error);
+            }
+        });
 
         connect(m_bleManager, &BleManager::deviceFound, this, &AirPodsTrayApp::bleDeviceFound);
-        connect(m_deviceInfo->getBattery(), &Battery::primaryChanged, this, &AirPodsTrayApp::primaryChanged);
         connect(m_systemSleepMonitor, &SystemSleepMonitor::systemGoingToSleep, this, &AirPodsTrayApp::onSystemGoingToSleep);
         connect(m_systemSleepMonitor, &SystemSleepMonitor::systemWakingUp, this, &AirPodsTrayApp::onSystemWakingUp);
 
@@ -107,8 +196,9 @@ public:
     ~AirPodsTrayApp() {
         saveCrossDeviceEnabled();
         saveEarDetectionSettings();
+        m_settingsStore->shutdown(); // Flush the debounced writes
 
-        delete socket;
+        // Device sockets are owned by their sessions
         delete phoneSocket;
     }
 
@@ -121,8 +211,14 @@ public:
     int retryAttempts() const { return m_retryAttempts; }
     bool hideOnStart() const { return m_hideOnStart; }
     DeviceInfo *deviceInfo() const { return m_deviceInfo; }
+    SessionManager *sessionManager() const { return m_sessionManager; }
+    HeadTrackingManager *headTracking() const { return m_headTracking; }
+    TelemetryStore *telemetry() const { return &TelemetryStore::instance(); }
     QString phoneMacStatus() const { return m_phoneMacStatus; }
 
+    // Point-in-time view of the runtime counters (see metricsregistry.hpp)
+    Q_INVOKABLE QVariantMap metricsSnapshot() const { return MetricsRegistry::instance().snapshot(); }
+
 private:
     bool debugMode;
     bool isConnectedLocally = false;
@@ -229,22 +325,15 @@ public slots:
         {
             LOG_DEBUG("Setting retry attempts to: " << attempts);
             m_retryAttempts = attempts;
+            if (m_connectionSupervisor)
+            {
+                m_connectionSupervisor->setMaxAttempts(ConnectionSupervisor::AirPods, attempts);
+            }
             emit retryAttemptsChanged(attempts);
             saveRetryAttempts(attempts);
         }
     }
 
-    void initiateMagicPairing()
-    {
-        if (!socket || !socket->isOpen())
-        {
-            LOG_ERROR("Socket nicht offen, Magic Pairing kann nicht gestartet werden");
-            return;
-        }
-
-        writePacketToSocket(AirPodsPackets::MagicPairing::REQUEST_MAGIC_CLOUD_KEYS, "Magic Pairing packet written: ");
-    }
-
     void setAdaptiveNoiseLevel(int level)
     {
         level = qBound(0, level, 100);
@@ -374,16 +463,16 @@ public slots:
     }
 
     bool loadCrossDeviceEnabled() { return m_settings->value("crossdevice/enabled", false).toBool(); }
-    void saveCrossDeviceEnabled() { m_settings->setValue("crossdevice/enabled", CrossDevice.isEnabled); }
+    void saveCrossDeviceEnabled() { m_settingsStore->set("crossdevice/enabled", CrossDevice.isEnabled); }
 
     int loadEarDetectionSettings() { return m_settings->value("earDetection/setting", MediaController::EarDetectionBehavior::PauseWhenOneRemoved).toInt(); }
-    void saveEarDetectionSettings() { m_settings->setValue("earDetection/setting", mediaController->getEarDetectionBehavior()); }
+    void saveEarDetectionSettings() { m_settingsStore->set("earDetection/setting", mediaController->getEarDetectionBehavior()); }
 
     bool loadNotificationsEnabled() const { return m_settings->value("notifications/enabled", true).toBool(); }
-    void saveNotificationsEnabled(bool enabled) { m_settings->setValue("notifications/enabled", enabled); }
+    void saveNotificationsEnabled(bool enabled) { m_settingsStore->set("notifications/enabled", enabled); }
 
     int loadRetryAttempts() const { return m_settings->value("bluetooth/retryAttempts", 3).toInt(); }
-    void saveRetryAttempts(int attempts) { m_settings->setValue("bluetooth/retryAttempts", attempts); }
+    void saveRetryAttempts(int attempts) { m_settingsStore->set("bluetooth/retryAttempts", attempts); }
 
     void onSystemGoingToSleep()
     {
@@ -395,13 +484,33 @@ public slots:
     }
     void onSystemWakingUp()
     {
-        LOG_INFO("System is waking up, starting ble scan");
-        m_bleManager->startScan();
+        LOG_INFO("System is waking up");
+
+        // Fast resume: the address and magic keys are already persisted, so
+        // try a direct connect to the cached device immediately instead of
+        // waiting out the scan -> advert -> connect chain. connectFinished
+        // picks up the L2CAP socket once BlueZ reports the link.
+        const QString cachedAddress = m_deviceInfo->bluetoothAddress();
+        if (!cachedAddress.isEmpty() && !areAirpodsConnected())
+        {
+            LOG_INFO("Attempting fast resume to cached device: " << cachedAddress);
+            monitor->connectDevice(cachedAddress);
+        }
+
+        // The scan stays on as fallback in case the direct connect fails
+        m_bleManager->boostScan();
     }
 
 private slots:
     void onTrayIconActivated()
     {
+        // With a --hide start no QML has been loaded yet; first activation
+        // brings up the window by loading it now
+        if (QGuiApplication::topLevelWindows().isEmpty())
+        {
+            loadMainModule();
+            return;
+        }
         QQuickWindow *window = qobject_cast<QQuickWindow *>(
             QGuiApplication::topLevelWindows().constFirst());
         if (window)
@@ -414,7 +523,7 @@ private slots:
 
     void onOpenApp()
     {
-        QObject *rootObject = parent->rootObjects().first();
+        QObject *rootObject = parent->rootObjects().value(0);
         if (rootObject) {
             QMetaObject::invokeMethod(rootObject, "reopen", Q_ARG(QVariant, "app"));
         }
@@ -426,7 +535,7 @@ private slots:
 
     void onOpenSettings()
     {
-        QObject *rootObject = parent->rootObjects().first();
+        QObject *rootObject = parent->rootObjects().value(0);
         if (rootObject) {
             QMetaObject::invokeMethod(rootObject, "reopen", Q_ARG(QVariant, "settings"));
         }
@@ -436,13 +545,56 @@ private slots:
         }
     }
 
-    void sendHandshake() {
-        LOG_INFO("Connected to device, sending initial packets");
-        writePacketToSocket(AirPodsPackets::Connection::HANDSHAKE, "Handshake packet written: ");
+    // Rebinds the tray, QML and RPA verifier to a session's DeviceInfo.
+    // Runs once for the bootstrap session during construction and again
+    // whenever the active session changes.
+    void bindActiveSession(DeviceSession *session)
+    {
+        if (m_deviceInfo)
+        {
+            disconnect(m_deviceInfo, nullptr, trayManager, nullptr);
+            disconnect(m_deviceInfo, nullptr, this, nullptr);
+            disconnect(m_deviceInfo->getBattery(), nullptr, this, nullptr);
+        }
+
+        m_deviceInfo = session->deviceInfo();
+        socket = session->socket();
+
+        connect(m_deviceInfo, &DeviceInfo::batteryLevelsChanged, trayManager, &TrayIconManager::updateBatteryStatus);
+        connect(m_deviceInfo, &DeviceInfo::noiseControlModeChanged, trayManager, &TrayIconManager::updateNoiseControlState);
+        connect(m_deviceInfo, &DeviceInfo::conversationalAwarenessChanged, trayManager, &TrayIconManager::updateConversationalAwareness);
+        // A new IRK makes every cached RPA verdict stale
+        connect(m_deviceInfo, &DeviceInfo::magicAccIRKChanged, this, [this](const QByteArray &irk) {
+            m_rpaVerifier.setIrk(irk);
+            m_rpaCache.clear();
+        });
+        connect(m_deviceInfo->getBattery(), &Battery::primaryChanged, this, &AirPodsTrayApp::primaryChanged);
+
+        // Re-key the verifier and repaint the tray with this session's state
+        m_rpaVerifier.setIrk(m_deviceInfo->magicAccIRK());
+        m_rpaCache.clear();
+        if (m_deviceInfo->batteryStatus().isEmpty())
+        {
+            trayManager->resetTrayIcon();
+        }
+        else
+        {
+            Battery *battery = m_deviceInfo->getBattery();
+            trayManager->updateBatteryStatus(battery->getState(Battery::Component::Left).level,
+                                             battery->getState(Battery::Component::Right).level,
+                                             battery->getState(Battery::Component::Case).level);
+            trayManager->updateNoiseControlState(m_deviceInfo->noiseControlMode());
+        }
+
+        emit deviceInfoChanged();
+        emit airPodsStatusChanged();
     }
 
     void bluezDeviceConnected(const QString &address, const QString &name)
     {
+        // BlueZ says the device is reachable: connect right away instead of
+        // waiting out whatever backoff a failed attempt left behind
+        m_connectionSupervisor->cancelPendingRetry(ConnectionSupervisor::AirPods);
         QBluetoothDeviceInfo device(QBluetoothAddress(address), name, 0);
         connectToDevice(device);
     }
@@ -453,7 +605,10 @@ private slots:
         if (socket)
         {
             LOG_WARN("Socket is still open, closing it");
-            socket->close();
+            if (DeviceSession *session = m_sessionManager->activeSession())
+            {
+                session->closeSocket();
+            }
             socket = nullptr;
         }
         if (phoneSocket && phoneSocket->isOpen())
@@ -464,7 +619,7 @@ private slots:
 
         // Clear the device name and model
         m_deviceInfo->reset();
-        m_bleManager->startScan();
+        m_bleManager->boostScan();
         emit airPodsStatusChanged();
 
         // Show system notification
@@ -476,11 +631,23 @@ private slots:
 
     void bluezDeviceDisconnected(const QString &address, const QString &name)
     {
-        if (address == m_deviceInfo->bluetoothAddress())
+        DeviceSession *session = m_sessionManager->sessionFor(address);
+        if (!session)
+        {
+            LOG_WARN("Disconnected device does not match any session: " << address);
+            return;
+        }
+        if (session == m_sessionManager->activeSession())
         {
             onDeviceDisconnected(QBluetoothAddress(address));
-        } else {
-            LOG_WARN("Disconnected device does not match connected device: " << address << " != " << m_deviceInfo->bluetoothAddress());
+        }
+        else
+        {
+            // Background sessions drop quietly; the tray keeps showing the
+            // active one
+            LOG_INFO("Background session disconnected: " << address);
+            session->closeSocket();
+            session->deviceInfo()->reset();
         }
     }
 
@@ -522,11 +689,14 @@ private slots:
             return str;
         };
 
+        // One batched notification for the whole packet's worth of setters
+        m_deviceInfo->beginUpdate();
         m_deviceInfo->setDeviceName(extractString());
         m_deviceInfo->setModelNumber(extractString());
         m_deviceInfo->setManufacturer(extractString());
 
         m_deviceInfo->setModel(parseModelNumber(m_deviceInfo->modelNumber()));
+        m_deviceInfo->endUpdate();
         emit modelChanged();
 
         // Log extracted metadata
@@ -544,7 +714,8 @@ private slots:
 
     void connectToDevice(const QBluetoothDeviceInfo &device)
     {
-        if (socket && socket->isOpen() && socket->peerAddress() == device.address())
+        DeviceSession *session = m_sessionManager->ensureSession(device.address().toString());
+        if (session->isConnected())
         {
             LOG_INFO("Already connected to the device: " << device.name());
             return;
@@ -552,46 +723,30 @@ private slots:
 
         LOG_INFO("Connecting to device: " << device.name());
 
-        // Clean up any existing socket
-        if (socket)
-        {
-            socket->close();
-            socket->deleteLater();
-            socket = nullptr;
-        }
+        m_lastAirPodsDevice = device; // Retries reconnect to the same device
 
+        // The session owns the socket and frames its byte stream; a replaced
+        // socket is cleaned up inside adoptSocket
         QBluetoothSocket *localSocket = new QBluetoothSocket(QBluetoothServiceInfo::L2capProtocol);
-        socket = localSocket;
+        session->adoptSocket(localSocket);
+        if (session == m_sessionManager->activeSession())
+        {
+            socket = localSocket;
+        }
 
         // Connection handler
-        auto handleConnection = [this, localSocket]()
-        {
-            connect(localSocket, &QBluetoothSocket::readyRead, this, [this, localSocket]()
-                    {
-            QByteArray data = localSocket->readAll();
-            QMetaObject::invokeMethod(this, "parseData", Qt::QueuedConnection, Q_ARG(QByteArray, data));
-            QMetaObject::invokeMethod(this, "relayPacketToPhone", Qt::QueuedConnection, Q_ARG(QByteArray, data)); });
-            sendHandshake();
+        auto handleConnection = [this, session]()
+        {
+            m_connectionSupervisor->noteConnected(ConnectionSupervisor::AirPods);
+            m_sessionManager->noteSessionConnected(session);
+            session->handshake().begin();
         };
 
-        // Error handler with retry
-        auto handleError = [this, device, localSocket](QBluetoothSocket::SocketError error)
+        // Error handler: the supervisor owns the retry schedule
+        auto handleError = [this, localSocket](QBluetoothSocket::SocketError error)
         {
             LOG_ERROR("Socket error: " << error << ", " << localSocket->errorString());
-
-            static int retryCount = 0;
-            if (retryCount < m_retryAttempts)
-            {
-                retryCount++;
-                LOG_INFO("Retrying connection (attempt " << retryCount << ")");
-                QTimer::singleShot(1500, this, [this, device]()
-                                   { connectToDevice(device); });
-            }
-            else
-            {
-                LOG_ERROR("Failed to connect after 3 attempts");
-                retryCount = 0;
-            }
+            m_connectionSupervisor->scheduleRetry(ConnectionSupervisor::AirPods);
         };
 
         connect(localSocket, &QBluetoothSocket::connected, this, handleConnection);
@@ -599,30 +754,28 @@ private slots:
                 this, handleError);
 
         localSocket->connectToService(device.address(), QBluetoothUuid("74ec2172-0bad-4d01-8f77-997b2be0722a"));
-        m_deviceInfo->setBluetoothAddress(device.address().toString());
+        session->deviceInfo()->setBluetoothAddress(device.address().toString());
         notifyAndroidDevice();
     }
 
-    void parseData(const QByteArray &data)
+    // Registers one handler per AAP packet header with the dispatcher so
+    // parseData can route in O(1) instead of walking every known header.
+    void registerPacketHandlers()
     {
-        LOG_DEBUG("Received: " << data.toHex());
-
-        if (data.startsWith(AirPodsPackets::Parse::HANDSHAKE_ACK))
+        // The handshake coordinator pipelines the post-ack requests and
+        // re-sends only what is still outstanding (see handshakecoordinator.hpp)
+        m_packetDispatcher.registerHandler(AirPodsPackets::Parse::HANDSHAKE_ACK, [this](const QByteArray &)
         {
-            writePacketToSocket(AirPodsPackets::Connection::SET_SPECIFIC_FEATURES, "Set specific features packet written: ");
-        }
-        else if (data.startsWith(AirPodsPackets::Parse::FEATURES_ACK))
+            m_parseSession->handshake().onHandshakeAck();
+        });
+
+        m_packetDispatcher.registerHandler(AirPodsPackets::Parse::FEATURES_ACK, [this](const QByteArray &)
         {
-            writePacketToSocket(AirPodsPackets::Connection::REQUEST_NOTIFICATIONS, "Request notifications packet written: ");
-            
-            QTimer::singleShot(2000, this, [this]() {
-                if (m_deviceInfo->batteryStatus().isEmpty()) {
-                    writePacketToSocket(AirPodsPackets::Connection::REQUEST_NOTIFICATIONS, "Request notifications packet written: ");
-                }
-            });
-        }
+            m_parseSession->handshake().onFeaturesAck();
+        });
+
         // Magic Cloud Keys Response
-        else if (data.startsWith(AirPodsPackets::MagicPairing::MAGIC_CLOUD_KEYS_HEADER))
+        m_packetDispatcher.registerHandler(AirPodsPackets::MagicPairing::MAGIC_CLOUD_KEYS_HEADER, [this](const QByteArray &data)
         {
             auto keys = AirPodsPackets::MagicPairing::parseMagicCloudKeysPacket(data);
             LOG_INFO("Received Magic Cloud Keys:");
@@ -630,50 +783,116 @@ private slots:
             LOG_INFO("MagicAccEncKey: " << keys.magicAccEncKey.toHex());
 
             // Store the keys
+            m_deviceInfo->beginUpdate();
             m_deviceInfo->setMagicAccIRK(keys.magicAccIRK);
             m_deviceInfo->setMagicAccEncKey(keys.magicAccEncKey);
-            m_deviceInfo->saveToSettings(*m_settings);
-        }
-        // Get CA state
-        else if (data.startsWith(AirPodsPackets::ConversationalAwareness::HEADER)) {
-            if (auto result = AirPodsPackets::ConversationalAwareness::parseState(data))
+            m_deviceInfo->endUpdate();
+            m_settingsStore->saveDeviceInfo(*m_deviceInfo);
+            m_parseSession->handshake().onMagicKeys();
+        });
+
+        // Control commands share the ControlCommand header, so they enter
+        // through one dispatcher entry and route by opcode. Adding a new
+        // command is a single registration line here. Receivers are resolved
+        // at dispatch time so toggles land on the originating session's
+        // DeviceInfo, not whichever one was bound at registration.
+        m_controlCommands.registerToggle<AirPodsPackets::ConversationalAwareness::Type, DeviceInfo>(
+            "Conversational awareness", [this]() { return m_deviceInfo; }, &DeviceInfo::setConversationalAwareness);
+        m_controlCommands.registerToggle<AirPodsPackets::OneBudANCMode::Type, DeviceInfo>(
+            "One Bud ANC mode", [this]() { return m_deviceInfo; }, &DeviceInfo::setOneBudANCMode);
+
+        // Noise Control Mode carries a mode value instead of a toggle
+        m_controlCommands.registerOpcode(0x0D, [this](const QByteArray &data)
+        {
+            if (data.size() != 11)
             {
-                m_deviceInfo->setConversationalAwareness(result.value());
-                LOG_INFO("Conversational awareness state received: " << m_deviceInfo->conversationalAwareness());
+                return;
             }
-        }
-        // Noise Control Mode
-        else if (data.size() == 11 && data.startsWith(AirPodsPackets::NoiseControl::HEADER))
-        {
             if (auto value = AirPodsPackets::NoiseControl::parseMode(data))
             {
                 m_deviceInfo->setNoiseControlMode(value.value());
                 LOG_INFO("Noise control mode received: " << m_deviceInfo->noiseControlMode());
             }
-        }
+        });
+
+        m_packetDispatcher.registerHandler(ControlCommand::HEADER, [this](const QByteArray &data)
+        {
+            if (!m_controlCommands.dispatch(data))
+            {
+                LOG_DEBUG("Unhandled control command: " << data.toHex());
+            }
+        });
+
         // Ear Detection
-        else if (data.size() == 8 && data.startsWith(AirPodsPackets::Parse::EAR_DETECTION))
+        m_packetDispatcher.registerHandler(AirPodsPackets::Parse::EAR_DETECTION, [this](const QByteArray &data)
         {
             m_deviceInfo->getEarDetection()->parseData(data);
             mediaController->handleEarDetection(m_deviceInfo->getEarDetection());
-        }
+        }, 8);
+
         // Battery Status
-        else if (data.size() == 22 && data.startsWith(AirPodsPackets::Parse::BATTERY_STATUS))
+        m_packetDispatcher.registerHandler(AirPodsPackets::Parse::BATTERY_STATUS, [this](const QByteArray &data)
         {
             m_deviceInfo->getBattery()->parsePacket(data);
+            LatencyTracker::instance().mark(LatencyTracker::StateApplied);
             m_deviceInfo->updateBatteryStatus();
+            m_parseSession->handshake().onBatteryStatus();
             LOG_INFO("Battery status: " << m_deviceInfo->batteryStatus());
-        }
-        // Conversational Awareness Data
-        else if (data.size() == 10 && data.startsWith(AirPodsPackets::ConversationalAwareness::DATA_HEADER))
+        }, 22);
+
+        // High-rate streams go through the batching stream stage instead of
+        // the general dispatcher: fields are extracted in place and each
+        // consumer runs once per socket drain (see streamstage.hpp).
+
+        // Conversational Awareness Data: only the newest level matters for
+        // the volume duck, so the batch collapses to its last sample
+        m_streamStage.registerStream(
+            AirPodsPackets::ConversationalAwareness::DATA_HEADER, 10,
+            [](const QByteArray &frame, StreamStage::Sample &out)
+            {
+                if (frame.size() != 10)
+                {
+                    return false;
+                }
+                out.a = frame.at(9) == 0x01;
+                return true;
+            },
+            [this](const StreamStage::Sample *samples, int count)
+            {
+                mediaController->handleConversationalAwareness(samples[count - 1].a != 0);
+            });
+
+        // Head tracking orientation (variable length, two headers): the
+        // whole batch goes into the worker's ring with a single wakeup
+        const auto headTrackingExtract = [](const QByteArray &frame, StreamStage::Sample &out)
         {
-            LOG_INFO("Received conversational awareness data");
-            mediaController->handleConversationalAwareness(data);
-        }
-        else if (data.startsWith(AirPodsPackets::Parse::METADATA))
+            const auto orientation = AirPodsPackets::HeadTracking::parseOrientation(frame);
+            if (!orientation)
+            {
+                return false;
+            }
+            out.a = orientation->horizontal;
+            out.b = orientation->vertical;
+            return true;
+        };
+        const auto headTrackingDeliver = [this](const StreamStage::Sample *samples, int count)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                m_headTracking->enqueueSample(static_cast<qint16>(samples[i].a),
+                                              static_cast<qint16>(samples[i].b));
+            }
+            m_headTracking->wakeWorker();
+        };
+        m_streamStage.registerStream(AirPodsPackets::HeadTracking::DATA_HEADER, -1,
+                                     headTrackingExtract, headTrackingDeliver);
+        m_streamStage.registerStream(AirPodsPackets::HeadTracking::DATA_HEADER_ALT, -1,
+                                     headTrackingExtract, headTrackingDeliver);
+
+        m_packetDispatcher.registerHandler(AirPodsPackets::Parse::METADATA, [this](const QByteArray &data)
         {
             parseMetadata(data);
-            initiateMagicPairing();
+            m_parseSession->handshake().onMetadata();
             mediaController->setConnectedDeviceMacAddress(m_deviceInfo->bluetoothAddress().replace(":", "_"));
             if (m_deviceInfo->getEarDetection()->oneOrMorePodsInEar()) // AirPods get added as output device only after this
             {
@@ -681,18 +900,54 @@ private slots:
             }
             m_bleManager->stopScan();
             emit airPodsStatusChanged();
+        });
+    }
+
+    void parseData(DeviceSession *session, const QByteArray &data)
+    {
+        LOG_DEBUG("Received: " << data.toHex());
+
+        // Byte 4 distinguishes AAP packet types under the shared prefix
+        const quint8 packetType = data.size() > 4 ? static_cast<quint8>(data.at(4)) : 0;
+
+        // High-rate stream frames extract in place and batch; they skip the
+        // dispatcher and the per-packet latency timeline entirely
+        if (m_streamStage.accept(data))
+        {
+            MetricsRegistry::instance().countPacket(packetType);
+            MetricsRegistry::instance().add(MetricsRegistry::PacketsParsed);
+            return;
         }
-        else if (data.startsWith(AirPodsPackets::OneBudANCMode::HEADER)) {
-            if (auto value = AirPodsPackets::OneBudANCMode::parseState(data))
-            {
-                m_deviceInfo->setOneBudANCMode(value.value());
-                LOG_INFO("One Bud ANC mode received: " << m_deviceInfo->oneBudANCMode());
-            }
+
+        LatencyTracker &latency = LatencyTracker::instance();
+        latency.beginFrame(packetType);
+
+        // Point the handler aliases at the originating session for the
+        // duration of the dispatch, so every registered handler — including
+        // ACK replies through writePacketToSocket — targets the session the
+        // frame came from, not whichever session the tray is showing
+        DeviceInfo *const previousInfo = m_deviceInfo;
+        QBluetoothSocket *const previousSocket = socket;
+        DeviceSession *const previousSession = m_parseSession;
+        m_deviceInfo = session->deviceInfo();
+        socket = session->socket();
+        m_parseSession = session;
+
+        if (m_packetDispatcher.dispatch(data))
+        {
+            MetricsRegistry::instance().countPacket(packetType);
+            MetricsRegistry::instance().add(MetricsRegistry::PacketsParsed);
         }
         else
         {
+            MetricsRegistry::instance().add(MetricsRegistry::PacketsUnrecognized);
             LOG_DEBUG("Unrecognized packet format: " << data.toHex());
         }
+
+        m_deviceInfo = previousInfo;
+        socket = previousSocket;
+        m_parseSession = previousSession;
+        latency.completeFrame();
     }
 
     void connectToPhone() {
@@ -714,6 +969,7 @@ private slots:
         phoneSocket = new QBluetoothSocket(QBluetoothServiceInfo::L2capProtocol);
         connect(phoneSocket, &QBluetoothSocket::connected, this, [this]() {
             LOG_INFO("Connected to phone");
+            m_connectionSupervisor->noteConnected(ConnectionSupervisor::Phone);
             if (!lastBatteryStatus.isEmpty()) {
                 phoneSocket->write(lastBatteryStatus);
                 LOG_DEBUG("Sent last battery status to phone: " << lastBatteryStatus.toHex());
@@ -722,10 +978,12 @@ private slots:
                 phoneSocket->write(lastEarDetectionStatus);
                 LOG_DEBUG("Sent last ear detection status to phone: " << lastEarDetectionStatus.toHex());
             }
+            m_phoneRelay->flush(); // Push anything queued while disconnected
         });
 
         connect(phoneSocket, QOverload<QBluetoothSocket::SocketError>::of(&QBluetoothSocket::errorOccurred), this, [this](QBluetoothSocket::SocketError error) {
             LOG_ERROR("Phone socket error: " << error << ", " << phoneSocket->errorString());
+            m_connectionSupervisor->scheduleRetry(ConnectionSupervisor::Phone);
         });
 
         phoneSocket->connectToService(phoneAddress, QBluetoothUuid("1abbb9a4-10e4-4000-a75c-8953c5471342"));
@@ -736,15 +994,7 @@ private slots:
         if (!CrossDevice.isEnabled) {
             return;
         }
-        if (phoneSocket && phoneSocket->isOpen())
-        {
-            phoneSocket->write(AirPodsPackets::Phone::NOTIFICATION + packet);
-        }
-        else
-        {
-            connectToPhone();
-            LOG_WARN("Phone socket is not open, cannot relay packet");
-        }
+        m_phoneRelay->enqueue(packet);
     }
 
     void handlePhonePacket(const QByteArray &packet) {
@@ -784,11 +1034,7 @@ private slots:
             if (socket && socket->isOpen()) {
                 socket->close();
                 LOG_INFO("Disconnected from AirPods");
-                QProcess process;
-                process.start("bluetoothctl", QStringList() << "disconnect" << m_deviceInfo->bluetoothAddress());
-                process.waitForFinished();
-                QString output = process.readAllStandardOutput().trimmed();
-                LOG_INFO("Bluetoothctl output: " << output);
+                monitor->disconnectDevice(m_deviceInfo->bluetoothAddress());
                 isConnectedLocally = false;
                 CrossDevice.isAvailable = true;
             }
@@ -812,7 +1058,8 @@ private slots:
 
     void bleDeviceFound(const BleInfo &device)
     {
-        if (BLEUtils::isValidIrkRpa(m_deviceInfo->magicAccIRK(), device.address)) {
+        if (isPairedRpa(device.address)) {
+            m_bleManager->notePairedDeviceSeen();
             m_deviceInfo->setModel(device.modelName);
             auto decryptet = BLEUtils::decryptLastBytes(device.encryptedPayload, m_deviceInfo->magicAccEncKey());
             m_deviceInfo->getBattery()->parseEncryptedPacket(decryptet, device.primaryLeft, device.isThisPodInTheCase);
@@ -820,6 +1067,36 @@ private slots:
         }
     }
 
+    // Answers "is this advertisement from our paired device" from a TTL cache
+    // before touching any crypto. An RPA stays stable for roughly 15 minutes,
+    // so both verdicts can be reused for that long; combined with the advert
+    // dedup in BleManager the steady-state BLE path is hash lookups only.
+    bool isPairedRpa(const QString &address)
+    {
+        const QDateTime now = QDateTime::currentDateTime();
+
+        auto it = m_rpaCache.constFind(address);
+        if (it != m_rpaCache.constEnd() && it->resolvedAt.secsTo(now) < RPA_CACHE_TTL_SECS) {
+            return it->matched;
+        }
+
+        // Cache miss or expired entry: one AES block against the cached key
+        // schedule, then remember the verdict either way
+        const bool matched = m_rpaVerifier.verify(address);
+
+        if (m_rpaCache.size() > RPA_CACHE_MAX_ENTRIES) {
+            for (auto pruneIt = m_rpaCache.begin(); pruneIt != m_rpaCache.end();) {
+                if (pruneIt->resolvedAt.secsTo(now) >= RPA_CACHE_TTL_SECS) {
+                    pruneIt = m_rpaCache.erase(pruneIt);
+                } else {
+                    ++pruneIt;
+                }
+            }
+        }
+        m_rpaCache.insert(address, {matched, now});
+        return matched;
+    }
+
 public:
     void handleMediaStateChange(MediaController::MediaState state) {
         if (state == MediaController::MediaState::Playing) {
@@ -855,12 +1132,11 @@ public:
         }
 
         if (force) {
+            // The connectFinished handler resumes the handoff once BlueZ
+            // reports the link is up; nothing blocks here
             LOG_INFO("Forcing connection to AirPods");
-            QProcess process;
-            process.start("bluetoothctl", QStringList() << "connect" << m_deviceInfo->bluetoothAddress());
-            process.waitForFinished();
-            QString output = process.readAllStandardOutput().trimmed();
-            LOG_INFO("Bluetoothctl output: " << output);
+            monitor->connectDevice(m_deviceInfo->bluetoothAddress());
+            return;
         }
         QBluetoothLocalDevice localDevice;
         const QList<QBluetoothAddress> connectedDevices = localDevice.connectedDevices();
@@ -878,13 +1154,18 @@ public:
     void initializeBluetooth() {
         connectToPhone();
 
-        m_deviceInfo->loadFromSettings(*m_settings);
+        // Binary snapshot restore: one read instead of INI parsing before
+        // the first connection attempt can start
+        m_settingsStore->restoreDeviceInfo(*m_deviceInfo, *m_settings);
         if (!areAirpodsConnected()) {
             m_bleManager->startScan();
         }
     }
 
     void loadMainModule() {
+        if (!parent->rootObjects().isEmpty()) {
+            return; // Main.qml is already loaded
+        }
         parent->load(QUrl(QStringLiteral("qrc:/linux/Main.qml")));
     }
 
@@ -904,6 +1185,7 @@ signals:
     void retryAttemptsChanged(int attempts);
     void oneBudANCModeChanged(bool enabled);
     void phoneMacStatusChanged();
+    void deviceInfoChanged();
 
 private:
     QBluetoothSocket *socket = nullptr;
@@ -914,29 +1196,103 @@ private:
     TrayIconManager *trayManager;
     BluetoothMonitor *monitor;
     QSettings *m_settings;
+    SettingsStore *m_settingsStore = nullptr;
     AutoStartManager *m_autoStartManager;
     int m_retryAttempts = 3;
     bool m_hideOnStart = false;
-    DeviceInfo *m_deviceInfo;
+    // Aliases of the active session's objects; handlers route through them
+    // and parseData repoints them at the originating session per frame
+    DeviceInfo *m_deviceInfo = nullptr;
+    DeviceSession *m_parseSession = nullptr; // Originating session during dispatch
+    SessionManager *m_sessionManager = nullptr;
+    HeadTrackingManager *m_headTracking = nullptr;
     BleManager *m_bleManager;
+    RpaVerifier m_rpaVerifier;
+
+    // TTL cache of RPA verification verdicts, positive and negative
+    struct RpaCacheEntry
+    {
+        bool matched = false;
+        QDateTime resolvedAt;
+    };
+    static constexpr int RPA_CACHE_TTL_SECS = 15 * 60;
+    static constexpr int RPA_CACHE_MAX_ENTRIES = 128;
+    QHash<QString, RpaCacheEntry> m_rpaCache;
     SystemSleepMonitor *m_systemSleepMonitor = nullptr;
     QString m_phoneMacStatus;
+    PacketDispatcher m_packetDispatcher;
+    ControlCommandRegistry m_controlCommands;
+    StreamStage m_streamStage;
+    PhoneRelayQueue *m_phoneRelay = nullptr;
+    ConnectionSupervisor *m_connectionSupervisor = nullptr;
+    QBluetoothDeviceInfo m_lastAirPodsDevice;
+};
+
+// Command mailbox living inside the single-instance shared memory segment.
+// A second launch writes its command and bumps the sequence counter; the
+// primary instance picks it up from its event loop without any socket I/O.
+struct InstanceMailbox
+{
+    quint32 sequence;
+    quint32 command;
+    qint64 heartbeatMs; // refreshed by the primary's poll timer
 };
 
+static constexpr quint32 MAILBOX_CMD_REOPEN = 1;
+// The segment outlives a crashed primary on Unix, so a second launch only
+// trusts the mailbox when the heartbeat shows someone still refreshing it;
+// the poll timer ticks every 100 ms, so this is a generous margin
+static constexpr qint64 MAILBOX_STALE_MS = 3000;
+
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
+    AsyncLogSink::install();
 
     QSharedMemory sharedMemory;
     sharedMemory.setKey("TcpServer-Key");
 
     // Check if app is already open
-    if(sharedMemory.create(1) == false) 
+    if(sharedMemory.create(sizeof(InstanceMailbox)) == false)
     {
-        LOG_INFO("Another instance already running! Opening App Window Instead");
+        // Deliver "reopen" through the mailbox: write, bump the counter, exit.
+        // This takes microseconds where the old local-socket handshake could
+        // stall for half a second in waitForConnected. The segment may also
+        // be a leftover from a crashed primary, so only trust it when the
+        // heartbeat is fresh.
+        if (sharedMemory.attach())
+        {
+            bool delivered = false;
+            if (sharedMemory.size() >= static_cast<int>(sizeof(InstanceMailbox)))
+            {
+                sharedMemory.lock();
+                auto *mailbox = static_cast<InstanceMailbox *>(sharedMemory.data());
+                const qint64 age = QDateTime::currentMSecsSinceEpoch() - mailbox->heartbeatMs;
+                if (age >= 0 && age < MAILBOX_STALE_MS)
+                {
+                    mailbox->command = MAILBOX_CMD_REOPEN;
+                    mailbox->sequence++;
+                    delivered = true;
+                }
+                sharedMemory.unlock();
+            }
+            if (delivered)
+            {
+                LOG_INFO("Another instance already running! Opening App Window Instead");
+                sharedMemory.detach();
+                return 0;
+            }
+            // Keep the attachment: if the socket probe below also finds no
+            // live primary, we become the primary and reuse the segment
+            LOG_INFO("Shared memory segment has no live heartbeat; probing the socket");
+        }
+
+        // Mailbox unavailable or stale (crashed primary, or a primary from
+        // an older build); fall back to the local socket path
         QLocalSocket socket;
         // Connect to the original app, then trigger the reopen signal
         socket.connectToServer("app_server");
         if (socket.waitForConnected(500)) {
+            LOG_INFO("Another instance already running! Opening App Window Instead");
             socket.write("reopen");
             socket.flush();
             socket.waitForBytesWritten(500);
@@ -979,7 +1335,72 @@ int main(int argc, char *argv[]) {
     }
 
     engine.addImageProvider("qrcode", new QRCodeImageProvider());
-    trayApp->loadMainModule();
+
+    // Autostarted --hide launches only need the tray icon: skip loading
+    // Main.qml (and instantiating the whole QML object tree) until the first
+    // open-app or tray activation, so every login pays only for the tray.
+    if (!hideOnStart) {
+        trayApp->loadMainModule();
+    }
+
+    auto triggerReopen = [&engine, trayApp]() {
+        QObject *rootObject = engine.rootObjects().value(0);
+        if (rootObject) {
+            QMetaObject::invokeMethod(rootObject, "reopen", Q_ARG(QVariant, "app"));
+        }
+        else
+        {
+            trayApp->loadMainModule();
+        }
+    };
+
+    // Poll the mailbox from the event loop; a second launch only has to bump
+    // the sequence counter for its command to land here. The fall-through
+    // above can leave us primary without a usable segment: a stale leftover
+    // from an old layout gets freed and re-created, a failed attach gets one
+    // more create attempt, and if that still fails we run socket-only.
+    if (sharedMemory.isAttached() &&
+        sharedMemory.size() < static_cast<int>(sizeof(InstanceMailbox)))
+    {
+        sharedMemory.detach(); // last attachment, so this frees the segment
+    }
+    if (!sharedMemory.isAttached() && !sharedMemory.create(sizeof(InstanceMailbox)))
+    {
+        LOG_ERROR("Single-instance mailbox unavailable, relying on the local socket");
+        LOG_DEBUG("Shared memory error: " << sharedMemory.errorString());
+    }
+    quint32 lastMailboxSequence = 0;
+    QTimer mailboxTimer;
+    if (sharedMemory.isAttached())
+    {
+        sharedMemory.lock();
+        auto *mailbox = static_cast<InstanceMailbox *>(sharedMemory.data());
+        mailbox->sequence = 0;
+        mailbox->command = 0;
+        mailbox->heartbeatMs = QDateTime::currentMSecsSinceEpoch();
+        sharedMemory.unlock();
+
+        mailboxTimer.setInterval(100);
+        QObject::connect(&mailboxTimer, &QTimer::timeout, [&]() {
+            sharedMemory.lock();
+            auto *mailbox = static_cast<InstanceMailbox *>(sharedMemory.data());
+            mailbox->heartbeatMs = QDateTime::currentMSecsSinceEpoch();
+            const quint32 sequence = mailbox->sequence;
+            const quint32 command = mailbox->command;
+            sharedMemory.unlock();
+
+            if (sequence == lastMailboxSequence) {
+                return;
+            }
+            lastMailboxSequence = sequence;
+
+            if (command == MAILBOX_CMD_REOPEN) {
+                LOG_INFO("Reopening app window (mailbox)");
+                triggerReopen();
+            }
+        });
+        mailboxTimer.start();
+    }
 
     QLocalServer server;
     QLocalServer::removeServer("app_server");
@@ -996,19 +1417,19 @@ int main(int argc, char *argv[]) {
     QObject::connect(&server, &QLocalServer::newConnection, [&]() {
         QLocalSocket* socket = server.nextPendingConnection();
         // Handles Proper Connection
-        QObject::connect(socket, &QLocalSocket::readyRead, [socket, &engine, &trayApp]() {
+        QObject::connect(socket, &QLocalSocket::readyRead, [socket, &triggerReopen]() {
             QString msg = socket->readAll();
             // Check if the message is "reopen", if so, trigger onOpenApp function
             if (msg == "reopen") {
                 LOG_INFO("Reopening app window");
-                QObject *rootObject = engine.rootObjects().first();
-                if (rootObject) {
-                    QMetaObject::invokeMethod(rootObject, "reopen", Q_ARG(QVariant, "app"));
-                }
-                else
-                {
-                    trayApp->loadMainModule();
-                }
+                triggerReopen();
+            }
+            else if (msg == "metrics") {
+                // Fleet monitoring scrapes the counters as JSON over the
+                // same local socket used for single-instance activation
+                const QJsonDocument doc(QJsonObject::fromVariantMap(MetricsRegistry::instance().snapshot()));
+                socket->write(doc.toJson(QJsonDocument::Compact));
+                socket->flush();
             }
             else
             {
@@ -1032,6 +1453,7 @@ int main(int argc, char *argv[]) {
     QObject::connect(&app, &QCoreApplication::aboutToQuit, [&]() {
         LOG_DEBUG("Application is about to quit. Cleaning up...");
         sharedMemory.detach();
+        AsyncLogSink::shutdown();
     });
     return app.exec();
 }
@@ -1,15 +1,14 @@
 #include "mediacontroller.h"
 #include "logger.h"
 #include "eardetection.hpp"
-#include "playerstatuswatcher.h"
+#include "mprisplayerregistry.h"
+#include "pulseaudioclient.h"
 
 #include <QDebug>
-#include <QProcess>
-#include <QRegularExpression>
-#include <QDBusConnection>
-#include <QDBusConnectionInterface>
 
 MediaController::MediaController(QObject *parent) : QObject(parent) {
+  pulseClient = new PulseAudioClient(this);
+  pulseClient->start();
 }
 
 void MediaController::handleEarDetection(EarDetection *earDetection)
@@ -76,8 +75,8 @@ void MediaController::setEarDetectionBehavior(EarDetectionBehavior behavior)
 }
 
 void MediaController::followMediaChanges() {
-  playerStatusWatcher = new PlayerStatusWatcher("", this);
-  connect(playerStatusWatcher, &PlayerStatusWatcher::playbackStatusChanged,
+  playerRegistry = new MprisPlayerRegistry(this);
+  connect(playerRegistry, &MprisPlayerRegistry::playbackStatusChanged,
           this, [this](const QString &status)
           {
             LOG_DEBUG("Playback status changed: " << status);
@@ -87,46 +86,31 @@ void MediaController::followMediaChanges() {
 }
 
 bool MediaController::isActiveOutputDeviceAirPods() {
-  QProcess process;
-  process.start("pactl", QStringList() << "get-default-sink");
-  process.waitForFinished();
-  QString output = process.readAllStandardOutput().trimmed();
-  LOG_DEBUG("Default sink: " << output);
-  return output.contains(connectedDeviceMacAddress);
+  // Answered from the client's subscribed state; no process spawn, no wait
+  QString defaultSink = pulseClient->defaultSinkName();
+  LOG_DEBUG("Default sink: " << defaultSink);
+  return !connectedDeviceMacAddress.isEmpty() && defaultSink.contains(connectedDeviceMacAddress);
 }
 
-void MediaController::handleConversationalAwareness(const QByteArray &data) {
-  LOG_DEBUG("Handling conversational awareness data: " << data.toHex());
-  bool lowered = data[9] == 0x01;
+void MediaController::handleConversationalAwareness(bool lowered) {
   LOG_INFO("Conversational awareness: " << (lowered ? "enabled" : "disabled"));
 
   if (lowered) {
     if (initialVolume == -1 && isActiveOutputDeviceAirPods()) {
-      QProcess process;
-      process.start("pactl", QStringList()
-                                 << "get-sink-volume" << "@DEFAULT_SINK@");
-      process.waitForFinished();
-      QString output = process.readAllStandardOutput();
-      QRegularExpression re("front-left: \\d+ /\\s*(\\d+)%");
-      QRegularExpressionMatch match = re.match(output);
-      if (match.hasMatch()) {
-        LOG_DEBUG("Matched: " << match.captured(1));
-        initialVolume = match.captured(1).toInt();
-      } else {
-        LOG_ERROR("Failed to parse initial volume from output: " << output);
+      initialVolume = pulseClient->defaultSinkVolumePercent();
+      if (initialVolume < 0) {
+        LOG_ERROR("Default sink volume not known yet, cannot duck volume");
+        initialVolume = -1;
         return;
       }
+      LOG_DEBUG("Initial volume: " << initialVolume);
     }
-    QProcess::execute(
-        "pactl", QStringList() << "set-sink-volume" << "@DEFAULT_SINK@"
-                               << QString::number(initialVolume * 0.20) + "%");
+    pulseClient->setDefaultSinkVolumePercent(initialVolume * 0.20);
     LOG_INFO("Volume lowered to 0.20 of initial which is "
              << initialVolume * 0.20 << "%");
   } else {
     if (initialVolume != -1 && isActiveOutputDeviceAirPods()) {
-      QProcess::execute("pactl", QStringList()
-                                     << "set-sink-volume" << "@DEFAULT_SINK@"
-                                     << QString::number(initialVolume) + "%");
+      pulseClient->setDefaultSinkVolumePercent(initialVolume);
       LOG_INFO("Volume restored to " << initialVolume << "%");
       initialVolume = -1;
     }
@@ -134,19 +118,18 @@ void MediaController::handleConversationalAwareness(const QByteArray &data) {
 }
 
 void MediaController::activateA2dpProfile() {
+  if (m_deviceOutputName.isEmpty()) {
+    // The card may register with PulseAudio after the MAC was set; the
+    // registry cache makes this retry free
+    m_deviceOutputName = getAudioDeviceName();
+  }
   if (connectedDeviceMacAddress.isEmpty() || m_deviceOutputName.isEmpty()) {
     LOG_WARN("Connected device MAC address or output name is empty, cannot activate A2DP profile");
     return;
   }
 
   LOG_INFO("Activating A2DP profile for AirPods");
-  int result = QProcess::execute(
-      "pactl", QStringList()
-                   << "set-card-profile"
-                   << m_deviceOutputName << "a2dp-sink");
-  if (result != 0) {
-    LOG_ERROR("Failed to activate A2DP profile");
-  }
+  pulseClient->setCardProfile(m_deviceOutputName, "a2dp-sink");
 }
 
 void MediaController::removeAudioOutputDevice() {
@@ -156,13 +139,7 @@ void MediaController::removeAudioOutputDevice() {
   }
   
   LOG_INFO("Removing AirPods as audio output device");
-  int result = QProcess::execute(
-      "pactl", QStringList()
-                   << "set-card-profile"
-                   << m_deviceOutputName << "off");
-  if (result != 0) {
-    LOG_ERROR("Failed to remove AirPods as audio output device");
-  }
+  pulseClient->setCardProfile(m_deviceOutputName, "off");
 }
 
 void MediaController::setConnectedDeviceMacAddress(const QString &macAddress) {
@@ -184,75 +161,18 @@ MediaController::MediaState MediaController::mediaStateFromPlayerctlOutput(
 
 MediaController::MediaState MediaController::getCurrentMediaState() const
 {
-  return mediaStateFromPlayerctlOutput(PlayerStatusWatcher::getCurrentPlaybackStatus(""));
+  // Answered from the registry's cached per-player state; no bus enumeration
+  return mediaStateFromPlayerctlOutput(playerRegistry ? playerRegistry->currentPlaybackStatus() : QString());
 }
 
 bool MediaController::sendMediaPlayerCommand(const QString &method)
 {
-  // Connect to the session bus
-  QDBusConnection bus = QDBusConnection::sessionBus();
-
-  // Find available MPRIS-compatible media players
-  QStringList services = bus.interface()->registeredServiceNames().value();
-  QStringList mprisServices;
-  for (const QString &service : services)
-  {
-    if (service.startsWith("org.mpris.MediaPlayer2."))
-    {
-      mprisServices << service;
-    }
-  }
-
-  if (mprisServices.isEmpty())
+  if (!playerRegistry)
   {
-    LOG_ERROR("No MPRIS-compatible media players found on DBus");
+    LOG_ERROR("Player registry not initialized, cannot send " << method);
     return false;
   }
-
-  bool success = false;
-  // Try each MPRIS service until one succeeds
-  for (const QString &service : mprisServices)
-  {
-    QDBusInterface playerInterface(
-        service,
-        "/org/mpris/MediaPlayer2",
-        "org.mpris.MediaPlayer2.Player",
-        bus);
-
-    if (!playerInterface.isValid())
-    {
-      LOG_ERROR("Invalid DBus interface for service: " << service);
-      continue;
-    }
-
-    // Send the Play or Pause command
-    if (method == "Play" || method == "Pause")
-    {
-      QDBusReply<void> reply = playerInterface.call(method);
-      if (reply.isValid())
-      {
-        LOG_INFO("Successfully sent " << method << " to " << service);
-        success = true;
-        break; // Exit after the first successful command
-      }
-      else
-      {
-        LOG_ERROR("Failed to send " << method << " to " << service
-                                    << ": " << reply.error().message());
-      }
-    }
-    else
-    {
-      LOG_ERROR("Unsupported method: " << method);
-      return false;
-    }
-  }
-
-  if (!success)
-  {
-    LOG_ERROR("No media player responded successfully to " << method);
-  }
-  return success;
+  return playerRegistry->sendCommand(method);
 }
 
 void MediaController::play()
@@ -288,40 +208,10 @@ QString MediaController::getAudioDeviceName()
 {
   if (connectedDeviceMacAddress.isEmpty()) { return QString(); }
 
-  // Set up QProcess to run pactl directly
-  QProcess process;
-  process.start("pactl", QStringList() << "list" << "cards" << "short");
-  if (!process.waitForFinished(3000)) // Timeout after 3 seconds
-  {
-    LOG_ERROR("pactl command failed or timed out: " << process.errorString());
-    return QString();
-  }
-
-  // Check for execution errors
-  if (process.exitCode() != 0)
+  QString cardName = pulseClient->findBluezCard(connectedDeviceMacAddress);
+  if (cardName.isEmpty())
   {
-    LOG_ERROR("pactl exited with error code: " << process.exitCode());
-    return QString();
+    LOG_ERROR("No matching Bluetooth card found for MAC address: " << connectedDeviceMacAddress);
   }
-
-  // Read and parse the command output
-  QString output = process.readAllStandardOutput();
-  QStringList lines = output.split("\n", Qt::SkipEmptyParts);
-
-  // Iterate through each line to find a matching Bluetooth sink
-  for (const QString &line : lines)
-  {
-    QStringList fields = line.split("\t", Qt::SkipEmptyParts);
-    if (fields.size() < 2) { continue; }
-
-    QString sinkName = fields[1].trimmed();
-    if (sinkName.startsWith("bluez") && sinkName.contains(connectedDeviceMacAddress))
-    {
-      return sinkName;
-    }
-  }
-
-  // No matching sink found
-  LOG_ERROR("No matching Bluetooth sink found for MAC address: " << connectedDeviceMacAddress);
-  return QString();
+  return cardName;
 }
\ No newline at end of file
@@ -3,9 +3,9 @@
 
 #include <QObject>
 
-class QProcess;
 class EarDetection;
-class PlayerStatusWatcher;
+class MprisPlayerRegistry;
+class PulseAudioClient;
 class QDBusInterface;
 
 class MediaController : public QObject
@@ -33,7 +33,7 @@ public:
   void handleEarDetection(EarDetection*);
   void followMediaChanges();
   bool isActiveOutputDeviceAirPods();
-  void handleConversationalAwareness(const QByteArray &data);
+  void handleConversationalAwareness(bool lowered);
   void activateA2dpProfile();
   void removeAudioOutputDevice();
   void setConnectedDeviceMacAddress(const QString &macAddress);
@@ -58,7 +58,8 @@ private:
   QString connectedDeviceMacAddress;
   EarDetectionBehavior earDetectionBehavior = PauseWhenOneRemoved;
   QString m_deviceOutputName;
-  PlayerStatusWatcher *playerStatusWatcher = nullptr;
+  MprisPlayerRegistry *playerRegistry = nullptr;
+  PulseAudioClient *pulseClient = nullptr;
 };
 
 #endif // MEDIACONTROLLER_H
\ No newline at end of file
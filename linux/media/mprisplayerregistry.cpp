@@ -0,0 +1,195 @@
+#include "mprisplayerregistry.h"
+#include "logger.h"
+
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusInterface>
+#include <QDBusReply>
+
+static const QString MPRIS_PREFIX = QStringLiteral("org.mpris.MediaPlayer2.");
+static const QString MPRIS_PATH = QStringLiteral("/org/mpris/MediaPlayer2");
+static const QString MPRIS_PLAYER_IFACE = QStringLiteral("org.mpris.MediaPlayer2.Player");
+
+MprisPlayerRegistry::MprisPlayerRegistry(QObject *parent) : QObject(parent)
+{
+    QDBusConnection bus = QDBusConnection::sessionBus();
+
+    // One owner-change subscription covers every player appearing or
+    // disappearing; no re-enumeration of the bus after startup
+    bus.connect("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                "org.freedesktop.DBus", "NameOwnerChanged",
+                this, SLOT(onNameOwnerChanged(QString,QString,QString)));
+
+    // Discover the players that are already on the bus
+    const QStringList services = bus.interface()->registeredServiceNames().value();
+    for (const QString &service : services)
+    {
+        if (service.startsWith(MPRIS_PREFIX))
+        {
+            addPlayer(service);
+        }
+    }
+}
+
+bool MprisPlayerRegistry::isAnyPlaying() const
+{
+    for (const Player &player : m_players)
+    {
+        if (player.playbackStatus == "Playing")
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString MprisPlayerRegistry::currentPlaybackStatus() const
+{
+    return isAnyPlaying() ? QStringLiteral("Playing") : QString();
+}
+
+bool MprisPlayerRegistry::sendCommand(const QString &method)
+{
+    if (method != "Play" && method != "Pause")
+    {
+        LOG_ERROR("Unsupported method: " << method);
+        return false;
+    }
+
+    if (m_players.isEmpty())
+    {
+        LOG_ERROR("No MPRIS-compatible media players in registry");
+        return false;
+    }
+
+    // Prefer the player that is currently playing so Pause hits the right one
+    QStringList ordered;
+    for (auto it = m_players.constBegin(); it != m_players.constEnd(); ++it)
+    {
+        if (it->playbackStatus == "Playing")
+        {
+            ordered.prepend(it.key());
+        }
+        else
+        {
+            ordered.append(it.key());
+        }
+    }
+
+    for (const QString &service : ordered)
+    {
+        QDBusReply<void> reply = m_players[service].interface->call(method);
+        if (reply.isValid())
+        {
+            LOG_INFO("Successfully sent " << method << " to " << service);
+            return true;
+        }
+        LOG_ERROR("Failed to send " << method << " to " << service
+                                    << ": " << reply.error().message());
+    }
+
+    LOG_ERROR("No media player responded successfully to " << method);
+    return false;
+}
+
+void MprisPlayerRegistry::onNameOwnerChanged(const QString &name, const QString &oldOwner, const QString &newOwner)
+{
+    if (!name.startsWith(MPRIS_PREFIX))
+    {
+        return;
+    }
+
+    if (!oldOwner.isEmpty())
+    {
+        m_ownerToService.remove(oldOwner);
+    }
+
+    if (newOwner.isEmpty())
+    {
+        removePlayer(name);
+    }
+    else
+    {
+        m_ownerToService.insert(newOwner, name);
+        addPlayer(name);
+    }
+}
+
+void MprisPlayerRegistry::onPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    Q_UNUSED(invalidated);
+
+    if (interface != MPRIS_PLAYER_IFACE || !changed.contains("PlaybackStatus"))
+    {
+        return;
+    }
+
+    // The sender is a unique bus name; map it back to the service we track
+    const QString service = m_ownerToService.value(QDBusContext::message().service());
+    const QString status = changed.value("PlaybackStatus").toString();
+
+    auto it = m_players.find(service);
+    if (it != m_players.end() && it->playbackStatus != status)
+    {
+        it->playbackStatus = status;
+        emit playbackStatusChanged(status);
+    }
+}
+
+void MprisPlayerRegistry::addPlayer(const QString &service)
+{
+    if (m_players.contains(service))
+    {
+        return;
+    }
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+
+    Player player;
+    player.interface = new QDBusInterface(service, MPRIS_PATH, MPRIS_PLAYER_IFACE, bus, this);
+    if (!player.interface->isValid())
+    {
+        delete player.interface;
+        return;
+    }
+
+    bus.connect(service, MPRIS_PATH, "org.freedesktop.DBus.Properties",
+                "PropertiesChanged", this, SLOT(onPropertiesChanged(QString,QVariantMap,QStringList)));
+
+    const QString owner = bus.interface()->serviceOwner(service).value();
+    if (!owner.isEmpty())
+    {
+        m_ownerToService.insert(owner, service);
+    }
+
+    // One initial read; the PropertiesChanged subscription keeps it current
+    const QVariant status = player.interface->property("PlaybackStatus");
+    player.playbackStatus = status.isValid() ? status.toString() : QString();
+
+    m_players.insert(service, player);
+    LOG_DEBUG("MPRIS player added: " << service << " status: " << player.playbackStatus);
+
+    if (player.playbackStatus == "Playing")
+    {
+        emit playbackStatusChanged(player.playbackStatus);
+    }
+}
+
+void MprisPlayerRegistry::removePlayer(const QString &service)
+{
+    auto it = m_players.find(service);
+    if (it == m_players.end())
+    {
+        return;
+    }
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    bus.disconnect(service, MPRIS_PATH, "org.freedesktop.DBus.Properties",
+                   "PropertiesChanged", this, SLOT(onPropertiesChanged(QString,QVariantMap,QStringList)));
+
+    delete it->interface;
+    m_players.erase(it);
+    LOG_DEBUG("MPRIS player removed: " << service);
+
+    emit playbackStatusChanged(currentPlaybackStatus());
+}
@@ -0,0 +1,54 @@
+#ifndef MPRISPLAYERREGISTRY_H
+#define MPRISPLAYERREGISTRY_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QtDBus/QDBusContext>
+
+class QDBusInterface;
+
+// Persistent registry of MPRIS media players on the session bus. Players are
+// discovered once at construction and tracked through NameOwnerChanged
+// afterwards; each player keeps a cached QDBusInterface handle and its
+// last-known PlaybackStatus, so "is anything playing" is answered from
+// memory and Play/Pause goes straight to a cached handle instead of
+// re-enumerating every bus name per command.
+class MprisPlayerRegistry : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+public:
+    explicit MprisPlayerRegistry(QObject *parent = nullptr);
+
+    bool isAnyPlaying() const;
+
+    // "Playing" when any player is playing, empty otherwise; mirrors the
+    // semantics of the old per-call bus enumeration.
+    QString currentPlaybackStatus() const;
+
+    // Sends Play or Pause, preferring a player that is currently playing.
+    // Returns true when a player accepted the command.
+    bool sendCommand(const QString &method);
+
+signals:
+    void playbackStatusChanged(const QString &status);
+
+private slots:
+    void onNameOwnerChanged(const QString &name, const QString &oldOwner, const QString &newOwner);
+    void onPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+
+private:
+    void addPlayer(const QString &service);
+    void removePlayer(const QString &service);
+
+    struct Player
+    {
+        QDBusInterface *interface = nullptr;
+        QString playbackStatus;
+    };
+
+    QHash<QString, Player> m_players;        // service name -> player
+    QHash<QString, QString> m_ownerToService; // unique bus name -> service name
+};
+
+#endif // MPRISPLAYERREGISTRY_H
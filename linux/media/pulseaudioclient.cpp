@@ -0,0 +1,384 @@
+#include "pulseaudioclient.h"
+#include "logger.h"
+
+#include <pulse/pulseaudio.h>
+
+#include <QMutexLocker>
+
+// Trampolines from the C callback signatures into the client. They run on
+// the PulseAudio mainloop thread.
+struct PulseAudioClientCallbacks
+{
+    static void contextState(pa_context *, void *userdata)
+    {
+        static_cast<PulseAudioClient *>(userdata)->onContextState();
+    }
+
+    static void subscribeEvent(pa_context *, pa_subscription_event_type_t type, uint32_t index, void *userdata)
+    {
+        static_cast<PulseAudioClient *>(userdata)->onSubscribeEvent(type, index);
+    }
+
+    static void serverInfo(pa_context *, const pa_server_info *info, void *userdata)
+    {
+        static_cast<PulseAudioClient *>(userdata)->onServerInfo(info);
+    }
+
+    static void sinkInfo(pa_context *, const pa_sink_info *info, int eol, void *userdata)
+    {
+        static_cast<PulseAudioClient *>(userdata)->onSinkInfo(info, eol);
+    }
+
+    static void cardInfo(pa_context *, const pa_card_info *info, int eol, void *userdata)
+    {
+        static_cast<PulseAudioClient *>(userdata)->onCardInfo(info, eol);
+    }
+
+    static void success(pa_context *, int success, void *userdata)
+    {
+        if (!success)
+        {
+            LOG_WARN("PulseAudio operation failed: " << static_cast<const char *>(userdata));
+        }
+    }
+};
+
+PulseAudioClient::PulseAudioClient(QObject *parent) : QObject(parent)
+{
+}
+
+PulseAudioClient::~PulseAudioClient()
+{
+    if (m_mainloop)
+    {
+        pa_threaded_mainloop_stop(m_mainloop);
+    }
+    if (m_context)
+    {
+        pa_context_disconnect(m_context);
+        pa_context_unref(m_context);
+    }
+    if (m_mainloop)
+    {
+        pa_threaded_mainloop_free(m_mainloop);
+    }
+}
+
+bool PulseAudioClient::start()
+{
+    m_mainloop = pa_threaded_mainloop_new();
+    if (!m_mainloop)
+    {
+        LOG_ERROR("Failed to create PulseAudio mainloop");
+        return false;
+    }
+
+    m_context = pa_context_new(pa_threaded_mainloop_get_api(m_mainloop), "librepods");
+    if (!m_context)
+    {
+        LOG_ERROR("Failed to create PulseAudio context");
+        pa_threaded_mainloop_free(m_mainloop);
+        m_mainloop = nullptr;
+        return false;
+    }
+
+    pa_context_set_state_callback(m_context, PulseAudioClientCallbacks::contextState, this);
+    if (pa_context_connect(m_context, nullptr, PA_CONTEXT_NOAUTOSPAWN, nullptr) < 0)
+    {
+        LOG_ERROR("Failed to connect PulseAudio context: " << pa_strerror(pa_context_errno(m_context)));
+        return false;
+    }
+
+    if (pa_threaded_mainloop_start(m_mainloop) < 0)
+    {
+        LOG_ERROR("Failed to start PulseAudio mainloop");
+        return false;
+    }
+    return true;
+}
+
+bool PulseAudioClient::isReady() const
+{
+    QMutexLocker locker(&m_stateMutex);
+    return m_ready;
+}
+
+QString PulseAudioClient::defaultSinkName() const
+{
+    QMutexLocker locker(&m_stateMutex);
+    return m_defaultSink;
+}
+
+int PulseAudioClient::defaultSinkVolumePercent() const
+{
+    QMutexLocker locker(&m_stateMutex);
+    return m_defaultSinkVolume;
+}
+
+void PulseAudioClient::setDefaultSinkVolumePercent(int percent)
+{
+    QString sink;
+    int channels;
+    {
+        QMutexLocker locker(&m_stateMutex);
+        if (!m_ready || m_defaultSink.isEmpty())
+        {
+            LOG_WARN("PulseAudio client not ready, cannot set volume");
+            return;
+        }
+        sink = m_defaultSink;
+        channels = m_defaultSinkChannels > 0 ? m_defaultSinkChannels : 2;
+    }
+
+    pa_cvolume volume;
+    pa_cvolume_set(&volume, static_cast<unsigned>(channels),
+                   static_cast<pa_volume_t>((static_cast<quint64>(qBound(0, percent, 150)) * PA_VOLUME_NORM) / 100));
+
+    pa_threaded_mainloop_lock(m_mainloop);
+    pa_operation *op = pa_context_set_sink_volume_by_name(
+        m_context, sink.toUtf8().constData(), &volume,
+        PulseAudioClientCallbacks::success, const_cast<char *>("set-sink-volume"));
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+    pa_threaded_mainloop_unlock(m_mainloop);
+}
+
+void PulseAudioClient::setCardProfile(const QString &cardName, const QString &profile)
+{
+    if (!isReady())
+    {
+        LOG_WARN("PulseAudio client not ready, cannot set card profile");
+        return;
+    }
+
+    pa_threaded_mainloop_lock(m_mainloop);
+    pa_operation *op = pa_context_set_card_profile_by_name(
+        m_context, cardName.toUtf8().constData(), profile.toUtf8().constData(),
+        PulseAudioClientCallbacks::success, const_cast<char *>("set-card-profile"));
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+    pa_threaded_mainloop_unlock(m_mainloop);
+}
+
+QString PulseAudioClient::findBluezCard(const QString &macFragment) const
+{
+    if (macFragment.isEmpty())
+    {
+        return QString();
+    }
+
+    QMutexLocker locker(&m_stateMutex);
+    for (const QString &name : m_cards)
+    {
+        if (name.startsWith("bluez") && name.contains(macFragment))
+        {
+            return name;
+        }
+    }
+    return QString();
+}
+
+void PulseAudioClient::onContextState()
+{
+    switch (pa_context_get_state(m_context))
+    {
+    case PA_CONTEXT_READY:
+    {
+        {
+            QMutexLocker locker(&m_stateMutex);
+            m_ready = true;
+        }
+        LOG_INFO("PulseAudio context ready");
+
+        // Track default sink and card changes instead of polling
+        pa_context_set_subscribe_callback(m_context, PulseAudioClientCallbacks::subscribeEvent, this);
+        pa_operation *op = pa_context_subscribe(
+            m_context,
+            static_cast<pa_subscription_mask_t>(PA_SUBSCRIPTION_MASK_SERVER | PA_SUBSCRIPTION_MASK_SINK | PA_SUBSCRIPTION_MASK_CARD),
+            nullptr, nullptr);
+        if (op)
+        {
+            pa_operation_unref(op);
+        }
+        requestServerInfo();
+        requestRegistrySnapshot();
+        break;
+    }
+    case PA_CONTEXT_FAILED:
+    case PA_CONTEXT_TERMINATED:
+    {
+        {
+            QMutexLocker locker(&m_stateMutex);
+            m_ready = false;
+            m_defaultSink.clear();
+            m_defaultSinkVolume = -1;
+            m_cards.clear();
+            m_sinks.clear();
+        }
+        LOG_WARN("PulseAudio context lost: " << pa_strerror(pa_context_errno(m_context)));
+        pa_threaded_mainloop_signal(m_mainloop, 0); // Wake any waiting query
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void PulseAudioClient::onSubscribeEvent(unsigned type, quint32 index)
+{
+    const unsigned facility = type & PA_SUBSCRIPTION_EVENT_FACILITY_MASK;
+    const unsigned operation = type & PA_SUBSCRIPTION_EVENT_TYPE_MASK;
+
+    if (facility == PA_SUBSCRIPTION_EVENT_SERVER)
+    {
+        requestServerInfo(); // Default sink may have changed
+    }
+    else if (facility == PA_SUBSCRIPTION_EVENT_SINK)
+    {
+        if (operation == PA_SUBSCRIPTION_EVENT_REMOVE)
+        {
+            QMutexLocker locker(&m_stateMutex);
+            m_sinks.remove(index);
+        }
+        else
+        {
+            requestSinkInfo(index); // Registry entry and volume may have changed
+        }
+    }
+    else if (facility == PA_SUBSCRIPTION_EVENT_CARD)
+    {
+        if (operation == PA_SUBSCRIPTION_EVENT_REMOVE)
+        {
+            QMutexLocker locker(&m_stateMutex);
+            m_cards.remove(index);
+        }
+        else
+        {
+            requestCardInfo(index);
+        }
+    }
+}
+
+void PulseAudioClient::onServerInfo(const pa_server_info *info)
+{
+    if (!info)
+    {
+        return;
+    }
+
+    const QString sink = QString::fromUtf8(info->default_sink_name ? info->default_sink_name : "");
+    bool changed = false;
+    {
+        QMutexLocker locker(&m_stateMutex);
+        if (m_defaultSink != sink)
+        {
+            m_defaultSink = sink;
+            m_defaultSinkVolume = -1;
+            changed = true;
+        }
+    }
+    if (changed)
+    {
+        // Hop to the GUI thread; we are on the PulseAudio mainloop thread
+        QMetaObject::invokeMethod(this, [this, sink]() { emit defaultSinkChanged(sink); }, Qt::QueuedConnection);
+    }
+    requestDefaultSinkInfo();
+}
+
+void PulseAudioClient::onSinkInfo(const pa_sink_info *info, int eol)
+{
+    if (eol || !info)
+    {
+        return;
+    }
+
+    const QString name = QString::fromUtf8(info->name);
+
+    QMutexLocker locker(&m_stateMutex);
+    m_sinks.insert(info->index, name);
+    if (m_defaultSink == name)
+    {
+        m_defaultSinkChannels = info->volume.channels;
+        m_defaultSinkVolume = static_cast<int>(
+            (static_cast<quint64>(pa_cvolume_avg(&info->volume)) * 100 + PA_VOLUME_NORM / 2) / PA_VOLUME_NORM);
+    }
+}
+
+void PulseAudioClient::onCardInfo(const pa_card_info *info, int eol)
+{
+    if (eol || !info)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_stateMutex);
+    m_cards.insert(info->index, QString::fromUtf8(info->name));
+}
+
+void PulseAudioClient::requestServerInfo()
+{
+    pa_operation *op = pa_context_get_server_info(m_context, PulseAudioClientCallbacks::serverInfo, this);
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+}
+
+void PulseAudioClient::requestDefaultSinkInfo()
+{
+    QString sink;
+    {
+        QMutexLocker locker(&m_stateMutex);
+        sink = m_defaultSink;
+    }
+    if (sink.isEmpty())
+    {
+        return;
+    }
+    pa_operation *op = pa_context_get_sink_info_by_name(
+        m_context, sink.toUtf8().constData(), PulseAudioClientCallbacks::sinkInfo, this);
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+}
+
+void PulseAudioClient::requestSinkInfo(quint32 index)
+{
+    pa_operation *op = pa_context_get_sink_info_by_index(
+        m_context, index, PulseAudioClientCallbacks::sinkInfo, this);
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+}
+
+void PulseAudioClient::requestCardInfo(quint32 index)
+{
+    pa_operation *op = pa_context_get_card_info_by_index(
+        m_context, index, PulseAudioClientCallbacks::cardInfo, this);
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+}
+
+// Populates the card/sink registry once at startup; the subscription keeps
+// it current afterwards.
+void PulseAudioClient::requestRegistrySnapshot()
+{
+    pa_operation *op = pa_context_get_card_info_list(m_context, PulseAudioClientCallbacks::cardInfo, this);
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+    op = pa_context_get_sink_info_list(m_context, PulseAudioClientCallbacks::sinkInfo, this);
+    if (op)
+    {
+        pa_operation_unref(op);
+    }
+}
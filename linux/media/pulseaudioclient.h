@@ -0,0 +1,77 @@
+#ifndef PULSEAUDIOCLIENT_H
+#define PULSEAUDIOCLIENT_H
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+struct pa_context;
+struct pa_threaded_mainloop;
+typedef struct pa_server_info pa_server_info;
+typedef struct pa_sink_info pa_sink_info;
+typedef struct pa_card_info pa_card_info;
+
+// Persistent native PulseAudio client replacing the pactl process spawns.
+// One async context lives for the whole session; the default sink, its
+// volume and a registry of cards and sinks are populated once and kept
+// current by subscribing to server change events, so the GUI thread answers
+// "are the AirPods the active output?" and the bluez card lookup from memory
+// while volume ducks / profile switches are fire-and-forget async operations
+// instead of fork-and-wait round trips.
+class PulseAudioClient : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PulseAudioClient(QObject *parent = nullptr);
+    ~PulseAudioClient() override;
+
+    // Connects the context and starts the client thread. Safe to call once.
+    bool start();
+    bool isReady() const;
+
+    // Cached state, maintained by the server subscription
+    QString defaultSinkName() const;
+    int defaultSinkVolumePercent() const; // -1 when unknown
+
+    // Async operations on the persistent context
+    void setDefaultSinkVolumePercent(int percent);
+    void setCardProfile(const QString &cardName, const QString &profile);
+
+    // Resolves the bluez card whose name contains the given MAC fragment
+    // from the cached card registry; an in-memory probe, no server round trip.
+    QString findBluezCard(const QString &macFragment) const;
+
+signals:
+    void defaultSinkChanged(const QString &sinkName);
+
+private:
+    // The C callback trampolines live in the .cpp and call back in here
+    friend struct PulseAudioClientCallbacks;
+
+    void onContextState();
+    void onSubscribeEvent(unsigned type, quint32 index);
+    void onServerInfo(const pa_server_info *info);
+    void onSinkInfo(const pa_sink_info *info, int eol);
+    void onCardInfo(const pa_card_info *info, int eol);
+
+    // Must be called with the mainloop lock held
+    void requestServerInfo();
+    void requestDefaultSinkInfo();
+    void requestSinkInfo(quint32 index);
+    void requestCardInfo(quint32 index);
+    void requestRegistrySnapshot();
+
+    pa_threaded_mainloop *m_mainloop = nullptr;
+    pa_context *m_context = nullptr;
+    bool m_ready = false;
+
+    mutable QMutex m_stateMutex;
+    QString m_defaultSink;
+    int m_defaultSinkVolume = -1; // percent
+    int m_defaultSinkChannels = 0;
+    QHash<quint32, QString> m_cards; // index -> card name
+    QHash<quint32, QString> m_sinks; // index -> sink name
+};
+
+#endif // PULSEAUDIOCLIENT_H
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <QString>
+#include <QVariantMap>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+/**
+ * @brief Lock-free runtime counters and gauges for the hot paths
+ *
+ * Updates are single relaxed atomic adds, cheap enough to leave enabled in
+ * production where the existing observability (grepping colored debug
+ * output) is not. Snapshots read the same atomics, so they can race with
+ * updates; each value is individually consistent, which is all fleet
+ * monitoring needs.
+ *
+ * Counters only go up; gauges track the current size of something. Per-type
+ * packet counts are keyed by the AAP type byte like the latency histograms
+ * (see latencytracker.hpp).
+ */
+class MetricsRegistry
+{
+public:
+    enum Counter
+    {
+        PacketsParsed = 0,     // frames routed by the dispatcher
+        PacketsUnrecognized,   // frames no handler claimed
+        AdvertsSeen,           // proximity advertisements received
+        AdvertsDeduped,        // dropped as identical rebroadcasts
+        AdvertsEmitted,        // passed the delta stage to deviceFound
+        DBusCallsIssued,       // async BlueZ round trips started
+        DBusCallsFailed,       // replies that carried an error
+        RelayPackets,          // frames forwarded to the phone
+        RelayBytes,            // bytes forwarded to the phone
+        RelayDropped,          // frames dropped by the bounded relay queue
+        ReconnectAttempts,     // socket error retries in connectToDevice
+        CounterCount
+    };
+
+    enum Gauge
+    {
+        SeenAdvertTableSize = 0, // entries in BleManager's dedup table
+        HandshakeAckMs,          // connect to HANDSHAKE_ACK, last connection
+        FirstMetadataMs,         // connect to first metadata packet
+        ConnectToBatteryMs,      // connect to first battery reading
+        GaugeCount
+    };
+
+    static MetricsRegistry &instance()
+    {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    void add(Counter counter, quint64 delta = 1)
+    {
+        m_counters[counter].fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void set(Gauge gauge, qint64 value)
+    {
+        m_gauges[gauge].store(value, std::memory_order_relaxed);
+    }
+
+    // Counts a dispatched frame under its AAP type byte
+    void countPacket(quint8 packetType)
+    {
+        m_packetCounts[packetType].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Flat name -> value map; QML reads it directly and the fleet dump
+    // serializes it as JSON
+    QVariantMap snapshot() const
+    {
+        static const char *counterNames[CounterCount] = {
+            "packetsParsed", "packetsUnrecognized", "advertsSeen",
+            "advertsDeduped", "advertsEmitted", "dbusCallsIssued",
+            "dbusCallsFailed", "relayPackets", "relayBytes",
+            "relayDropped", "reconnectAttempts"};
+        static const char *gaugeNames[GaugeCount] = {"seenAdvertTableSize", "handshakeAckMs",
+                                                     "firstMetadataMs", "connectToBatteryMs"};
+
+        QVariantMap map;
+        for (int i = 0; i < CounterCount; i++)
+        {
+            map.insert(QLatin1String(counterNames[i]),
+                       m_counters[i].load(std::memory_order_relaxed));
+        }
+        for (int i = 0; i < GaugeCount; i++)
+        {
+            map.insert(QLatin1String(gaugeNames[i]),
+                       m_gauges[i].load(std::memory_order_relaxed));
+        }
+        for (int type = 0; type < 256; type++)
+        {
+            const quint64 count = m_packetCounts[type].load(std::memory_order_relaxed);
+            if (count > 0)
+            {
+                map.insert(QStringLiteral("packets.0x%1").arg(type, 2, 16, QLatin1Char('0')), count);
+            }
+        }
+        return map;
+    }
+
+private:
+    MetricsRegistry() = default;
+
+    std::array<std::atomic<quint64>, CounterCount> m_counters{};
+    std::array<std::atomic<qint64>, GaugeCount> m_gauges{};
+    std::array<std::atomic<quint64>, 256> m_packetCounts{};
+};
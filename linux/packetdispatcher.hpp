@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <algorithm>
+#include <functional>
+
+// Routes incoming AAP packets to their handler by header prefix instead of
+// scanning every known header in sequence. Handlers are registered once at
+// startup; dispatch() does a single hash lookup per registered header length
+// (longest first, so the more specific control-command headers win over their
+// shared prefix), which keeps the hot packets like conversational awareness
+// data, ear detection and battery status from paying for every miss on the
+// way to their branch.
+class PacketDispatcher
+{
+public:
+    using Handler = std::function<void(const QByteArray &)>;
+
+    // exactSize restricts the handler to packets of that total length,
+    // mirroring the size checks the individual parsers expect. -1 accepts
+    // any length.
+    void registerHandler(const QByteArray &header, Handler handler, int exactSize = -1)
+    {
+        m_handlers.insert(header, {std::move(handler), exactSize});
+        if (!m_headerLengths.contains(header.size()))
+        {
+            m_headerLengths.append(header.size());
+            std::sort(m_headerLengths.begin(), m_headerLengths.end(), std::greater<int>());
+        }
+    }
+
+    // Returns false when no handler matched so the caller can log the miss.
+    // The lookup key is a raw-data view over the packet, so dispatching does
+    // not allocate.
+    bool dispatch(const QByteArray &data) const
+    {
+        for (int length : m_headerLengths)
+        {
+            if (data.size() < length)
+            {
+                continue;
+            }
+            auto it = m_handlers.constFind(QByteArray::fromRawData(data.constData(), length));
+            if (it == m_handlers.constEnd())
+            {
+                continue;
+            }
+            if (it->exactSize != -1 && data.size() != it->exactSize)
+            {
+                continue;
+            }
+            it->handler(data);
+            return true;
+        }
+        return false;
+    }
+
+    // Returns the exact frame length registered for the header at the front
+    // of data, or -1 when the header is unknown or has no fixed size. Used by
+    // the framing layer to split coalesced socket reads into frames.
+    int expectedSize(const QByteArray &data) const
+    {
+        for (int length : m_headerLengths)
+        {
+            if (data.size() < length)
+            {
+                continue;
+            }
+            auto it = m_handlers.constFind(QByteArray::fromRawData(data.constData(), length));
+            if (it != m_handlers.constEnd())
+            {
+                return it->exactSize;
+            }
+        }
+        return -1;
+    }
+
+private:
+    struct Entry
+    {
+        Handler handler;
+        int exactSize;
+    };
+
+    QHash<QByteArray, Entry> m_handlers;
+    QList<int> m_headerLengths; // Sorted longest-first
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QByteArray>
+#include <array>
+#include <cstdint>
+
+// Compile-time hex parsing for the AAP packet constants. The tables live as
+// constexpr std::array data in the binary's read-only section, so building
+// the packet constants does zero work at process startup and comparisons run
+// against flat in-section data instead of heap-backed QByteArrays.
+namespace PacketHex
+{
+    constexpr uint8_t nibble(char c)
+    {
+        return (c >= '0' && c <= '9')   ? static_cast<uint8_t>(c - '0')
+               : (c >= 'a' && c <= 'f') ? static_cast<uint8_t>(c - 'a' + 10)
+               : (c >= 'A' && c <= 'F') ? static_cast<uint8_t>(c - 'A' + 10)
+                                        : throw "invalid hex digit";
+    }
+
+    // Parses a hex string literal into a byte table at compile time.
+    template <size_t N>
+    constexpr std::array<uint8_t, (N - 1) / 2> fromHex(const char (&hex)[N])
+    {
+        static_assert((N - 1) % 2 == 0, "hex literal must have an even number of digits");
+        std::array<uint8_t, (N - 1) / 2> out{};
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            out[i] = static_cast<uint8_t>((nibble(hex[2 * i]) << 4) | nibble(hex[2 * i + 1]));
+        }
+        return out;
+    }
+
+    // Appends a single byte to a table, e.g. a command identifier after the
+    // shared control-command header.
+    template <size_t N>
+    constexpr std::array<uint8_t, N + 1> append(const std::array<uint8_t, N> &bytes, uint8_t value)
+    {
+        std::array<uint8_t, N + 1> out{};
+        for (size_t i = 0; i < N; ++i)
+        {
+            out[i] = bytes[i];
+        }
+        out[N] = value;
+        return out;
+    }
+
+    // Wraps a compile-time table in a QByteArray without copying. The result
+    // aliases the in-section data, so it never allocates; only use this for
+    // tables with static storage duration.
+    template <size_t N>
+    inline QByteArray view(const std::array<uint8_t, N> &bytes)
+    {
+        return QByteArray::fromRawData(reinterpret_cast<const char *>(bytes.data()), static_cast<qsizetype>(N));
+    }
+
+    // Deep copy for runtime-assembled packets that must own their storage.
+    template <size_t N>
+    inline QByteArray copy(const std::array<uint8_t, N> &bytes)
+    {
+        return QByteArray(reinterpret_cast<const char *>(bytes.data()), static_cast<qsizetype>(N));
+    }
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVarLengthArray>
+#include <functional>
+
+#include "airpods_packets.h"
+#include "logger.h"
+#include "metricsregistry.hpp"
+
+// Backpressure-aware write queue for the phone relay. Instead of one
+// allocation and one socket write per AirPods packet, frames accumulate in a
+// reused buffer (notification header appended in place, no intermediate
+// concatenation) and a short coalescing timer folds a burst into a single
+// write. State packets where only the latest matters — battery, ear
+// detection, conversational awareness — supersede their queued predecessor
+// rather than piling up, and reconnect attempts while the socket is down are
+// rate-limited instead of fired per packet.
+//
+// Frames handed to enqueue() may alias the framer's buffer; they are copied
+// into the pending buffer immediately, so slices are safe to pass.
+class PhoneRelayQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    using WriteSink = std::function<qint64(const QByteArray &payload)>;
+    using AvailableProbe = std::function<bool()>;
+    using ReconnectRequest = std::function<void()>;
+
+    explicit PhoneRelayQueue(QObject *parent = nullptr) : QObject(parent)
+    {
+        m_pendingBuffer.reserve(MAX_PENDING_BYTES);
+        m_flushTimer.setSingleShot(true);
+        m_flushTimer.setInterval(COALESCE_MS);
+        connect(&m_flushTimer, &QTimer::timeout, this, &PhoneRelayQueue::flush);
+    }
+
+    void setWriteSink(WriteSink sink) { m_write = std::move(sink); }
+    void setAvailableProbe(AvailableProbe probe) { m_available = std::move(probe); }
+    void setReconnectRequest(ReconnectRequest request) { m_reconnect = std::move(request); }
+
+    void enqueue(const QByteArray &packet)
+    {
+        if (!m_available || !m_available())
+        {
+            requestReconnect();
+            return;
+        }
+
+        const int key = latestOnlyKey(packet);
+        if (key >= 0)
+        {
+            // Only the newest frame of this type is worth relaying
+            for (Entry &entry : m_entries)
+            {
+                if (entry.key == key && entry.live)
+                {
+                    entry.live = false;
+                    m_liveBytes -= entry.length;
+                }
+            }
+        }
+
+        const int framed = AirPodsPackets::Phone::NOTIFICATION.size() + packet.size();
+        if (m_liveBytes + framed > MAX_PENDING_BYTES)
+        {
+            MetricsRegistry::instance().add(MetricsRegistry::RelayDropped);
+            LOG_WARN("Phone relay queue full, dropping packet");
+            return;
+        }
+
+        Entry entry;
+        entry.offset = m_pendingBuffer.size();
+        entry.length = framed;
+        entry.key = key;
+        m_pendingBuffer.append(AirPodsPackets::Phone::NOTIFICATION);
+        m_pendingBuffer.append(packet);
+        m_entries.append(entry);
+        m_liveBytes += framed;
+
+        if (!m_flushTimer.isActive())
+        {
+            m_flushTimer.start();
+        }
+    }
+
+    // Writes everything pending as one payload; also called externally when
+    // the socket (re)connects to push frames queued in the meantime
+    void flush()
+    {
+        if (m_entries.isEmpty())
+        {
+            return;
+        }
+        if (!m_available || !m_available())
+        {
+            requestReconnect();
+            return; // Keep the queue; a reconnect will flush it
+        }
+
+        qint64 written = 0;
+        int packets = 0;
+        if (m_liveBytes == m_pendingBuffer.size())
+        {
+            // Nothing superseded: the pending buffer is the payload
+            written = m_write(m_pendingBuffer);
+            packets = m_entries.size();
+        }
+        else
+        {
+            QByteArray payload;
+            payload.reserve(m_liveBytes);
+            for (const Entry &entry : m_entries)
+            {
+                if (entry.live)
+                {
+                    payload.append(m_pendingBuffer.constData() + entry.offset, entry.length);
+                    packets++;
+                }
+            }
+            written = m_write(payload);
+        }
+
+        if (written > 0)
+        {
+            MetricsRegistry::instance().add(MetricsRegistry::RelayPackets, packets);
+            MetricsRegistry::instance().add(MetricsRegistry::RelayBytes, written);
+        }
+
+        m_pendingBuffer.resize(0); // Keeps the reserved capacity
+        m_entries.clear();
+        m_liveBytes = 0;
+    }
+
+private:
+    static constexpr int COALESCE_MS = 20;
+    static constexpr int MAX_PENDING_BYTES = 4096;
+    static constexpr int RECONNECT_MIN_INTERVAL_MS = 5000;
+
+    struct Entry
+    {
+        int offset = 0;
+        int length = 0;
+        int key = -1; // latest-only type byte, or -1
+        bool live = true;
+    };
+
+    // AAP type bytes whose frames carry full state: a newer frame makes any
+    // queued older one stale
+    static int latestOnlyKey(const QByteArray &packet)
+    {
+        if (packet.size() <= 4)
+        {
+            return -1;
+        }
+        const quint8 type = static_cast<quint8>(packet.at(4));
+        switch (type)
+        {
+        case 0x04: // battery status
+        case 0x06: // ear detection
+        case 0x4B: // conversational awareness data
+            return type;
+        default:
+            return -1;
+        }
+    }
+
+    void requestReconnect()
+    {
+        if (!m_reconnect)
+        {
+            return;
+        }
+        if (m_sinceReconnect.isValid() && m_sinceReconnect.elapsed() < RECONNECT_MIN_INTERVAL_MS)
+        {
+            return;
+        }
+        m_sinceReconnect.restart();
+        m_reconnect();
+    }
+
+    QByteArray m_pendingBuffer;
+    QVarLengthArray<Entry, 16> m_entries;
+    int m_liveBytes = 0;
+    QTimer m_flushTimer;
+    QElapsedTimer m_sinceReconnect;
+    WriteSink m_write;
+    AvailableProbe m_available;
+    ReconnectRequest m_reconnect;
+};
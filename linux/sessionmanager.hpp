@@ -0,0 +1,121 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <functional>
+
+#include "devicesession.hpp"
+
+// Maintains N concurrent device sessions multiplexed through one parse
+// pipeline, so a second pair of AirPods shares the single BLE scanner and
+// D-Bus monitor instead of needing a second app instance. Every session's
+// framer feeds the same frame sink, tagged with the originating session;
+// the tray and QML bind to the active session only.
+class SessionManager : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(DeviceSession *activeSession READ activeSession NOTIFY activeSessionChanged)
+    Q_PROPERTY(QStringList sessionAddresses READ sessionAddresses NOTIFY sessionsChanged)
+
+public:
+    using FrameSink = std::function<void(DeviceSession *session, const QByteArray &frame)>;
+    using LengthProbe = std::function<int(const QByteArray &frame)>;
+    using BatchEnd = std::function<void()>;
+
+    explicit SessionManager(QObject *parent = nullptr) : QObject(parent) {}
+
+    // Shared parse pipeline: every session's framer routes here
+    void setFrameSink(FrameSink sink) { m_frameSink = std::move(sink); }
+    void setLengthProbe(LengthProbe probe) { m_lengthProbe = std::move(probe); }
+    void setBatchEnd(BatchEnd hook) { m_batchEnd = std::move(hook); }
+
+    DeviceSession *activeSession() const { return m_active; }
+
+    DeviceSession *sessionFor(const QString &address) const
+    {
+        return m_sessions.value(address.toUpper(), nullptr);
+    }
+
+    // Returns the session for this address, binding the not-yet-addressed
+    // bootstrap session first and only then creating a new one
+    DeviceSession *ensureSession(const QString &address)
+    {
+        const QString key = address.toUpper();
+        if (DeviceSession *existing = m_sessions.value(key, nullptr))
+        {
+            return existing;
+        }
+        if (m_active && !m_active->isBound() && !key.isEmpty())
+        {
+            m_sessions.remove(QString());
+            m_active->setAddress(key);
+            m_sessions.insert(key, m_active);
+            emit sessionsChanged();
+            return m_active;
+        }
+
+        auto *session = new DeviceSession(key, this);
+        session->framer().setLengthProbe(m_lengthProbe);
+        session->framer().setBatchEnd(m_batchEnd);
+        session->framer().setFrameSink([this, session](const QByteArray &frame) {
+            if (m_frameSink)
+            {
+                m_frameSink(session, frame);
+            }
+        });
+        m_sessions.insert(key, session);
+        if (!m_active)
+        {
+            setActiveSession(session);
+        }
+        emit sessionsChanged();
+        return session;
+    }
+
+    void setActiveSession(DeviceSession *session)
+    {
+        if (m_active == session)
+        {
+            return;
+        }
+        m_active = session;
+        emit activeSessionChanged(session);
+    }
+
+    Q_INVOKABLE void activateSession(const QString &address)
+    {
+        if (DeviceSession *session = sessionFor(address))
+        {
+            setActiveSession(session);
+        }
+    }
+
+    // A session finished its handshake: promote it when the tray is showing
+    // nothing better, i.e. there is no connected active session
+    void noteSessionConnected(DeviceSession *session)
+    {
+        if (!m_active || !m_active->isConnected())
+        {
+            setActiveSession(session);
+        }
+    }
+
+    QStringList sessionAddresses() const
+    {
+        QStringList addresses = m_sessions.keys();
+        addresses.sort();
+        return addresses;
+    }
+
+signals:
+    void activeSessionChanged(DeviceSession *session);
+    void sessionsChanged();
+
+private:
+    QHash<QString, DeviceSession *> m_sessions;
+    DeviceSession *m_active = nullptr;
+    FrameSink m_frameSink;
+    LengthProbe m_lengthProbe;
+    BatchEnd m_batchEnd;
+};
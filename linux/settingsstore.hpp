@@ -0,0 +1,212 @@
+#pragma once
+
+#include <QDir>
+#include <QFile>
+#include <QObject>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QVariantHash>
+#include <cstring>
+
+#include "deviceinfo.hpp"
+#include "logger.h"
+
+// Applies batched settings writes off the GUI thread. Owns its own
+// QSettings instance so the GUI-side object never syncs; the snapshot is
+// committed through QSaveFile so a crash mid-write leaves the previous
+// snapshot intact.
+class SettingsWriteWorker : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void applyBatch(const QVariantHash &batch, const QByteArray &snapshot, const QString &snapshotPath)
+    {
+        if (!batch.isEmpty())
+        {
+            QSettings settings("AirPodsTrayApp", "AirPodsTrayApp");
+            for (auto it = batch.constBegin(); it != batch.constEnd(); ++it)
+            {
+                settings.setValue(it.key(), it.value());
+            }
+            settings.sync();
+        }
+
+        if (!snapshot.isEmpty())
+        {
+            QSaveFile file(snapshotPath);
+            if (file.open(QIODevice::WriteOnly))
+            {
+                file.write(snapshot);
+                file.commit();
+            }
+            else
+            {
+                LOG_ERROR("Cannot write device snapshot: " << file.errorString());
+            }
+        }
+    }
+};
+
+// Debounced settings persistence. Setters mark keys dirty in memory and a
+// short timer batches them onto the writer thread, so a burst of changes
+// (every toggle used to sync the INI file synchronously on the GUI
+// thread) costs one file touch instead of one per change. DeviceInfo is
+// additionally captured into a fixed-layout versioned binary snapshot
+// that restoreDeviceInfo() reads back in a single pread at startup —
+// the fast-resume path no longer waits on INI string parsing.
+class SettingsStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SettingsStore(QObject *parent = nullptr) : QObject(parent)
+    {
+        m_thread = new QThread(this);
+        m_worker = new SettingsWriteWorker;
+        m_worker->moveToThread(m_thread);
+        connect(this, &SettingsStore::batchReady, m_worker, &SettingsWriteWorker::applyBatch);
+        connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+        m_thread->start();
+
+        m_flushTimer.setSingleShot(true);
+        m_flushTimer.setInterval(FLUSH_DELAY_MS);
+        connect(&m_flushTimer, &QTimer::timeout, this, &SettingsStore::flush);
+
+        const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        QDir().mkpath(dir);
+        m_snapshotPath = dir + "/devicestate.bin";
+    }
+
+    ~SettingsStore() override { shutdown(); }
+
+    // Marks one key dirty; the write lands on the worker after the
+    // debounce window closes
+    void set(const QString &key, const QVariant &value)
+    {
+        m_pending.insert(key, value);
+        m_flushTimer.start();
+    }
+
+    // Persists DeviceInfo both ways: the INI keys for compatibility and
+    // the binary snapshot for the fast startup restore
+    void saveDeviceInfo(const DeviceInfo &info)
+    {
+        set("DeviceInfo/deviceName", info.deviceName());
+        set("DeviceInfo/model", static_cast<int>(info.model()));
+        set("DeviceInfo/magicAccIRK", info.magicAccIRK());
+        set("DeviceInfo/magicAccEncKey", info.magicAccEncKey());
+
+        DeviceSnapshot snapshot = {};
+        snapshot.magic = SNAPSHOT_MAGIC;
+        snapshot.version = SNAPSHOT_VERSION;
+        snapshot.size = sizeof(DeviceSnapshot);
+        copyString(snapshot.address, sizeof(snapshot.address), info.bluetoothAddress());
+        copyString(snapshot.deviceName, sizeof(snapshot.deviceName), info.deviceName());
+        snapshot.model = static_cast<qint32>(info.model());
+        copyKey(snapshot.irk, snapshot.irkSize, info.magicAccIRK());
+        copyKey(snapshot.encKey, snapshot.encKeySize, info.magicAccEncKey());
+        m_snapshot = QByteArray(reinterpret_cast<const char *>(&snapshot), sizeof(snapshot));
+        m_flushTimer.start();
+    }
+
+    // One read restores the whole device state; falls back to the INI keys
+    // when the snapshot is missing or from another layout version
+    bool restoreDeviceInfo(DeviceInfo &info, const QSettings &fallback)
+    {
+        QFile file(m_snapshotPath);
+        DeviceSnapshot snapshot;
+        if (file.open(QIODevice::ReadOnly) &&
+            file.read(reinterpret_cast<char *>(&snapshot), sizeof(snapshot)) == sizeof(snapshot) &&
+            snapshot.magic == SNAPSHOT_MAGIC && snapshot.version == SNAPSHOT_VERSION &&
+            snapshot.size == sizeof(DeviceSnapshot))
+        {
+            info.beginUpdate();
+            // The address is what the fast-resume reconnect path keys on;
+            // without it a fresh start has to scan before it can connect
+            info.setBluetoothAddress(QString::fromUtf8(snapshot.address));
+            info.setDeviceName(QString::fromUtf8(snapshot.deviceName));
+            info.setModel(static_cast<AirpodsTrayApp::Enums::AirPodsModel>(snapshot.model));
+            info.setMagicAccIRK(QByteArray(reinterpret_cast<const char *>(snapshot.irk),
+                                           qMin<int>(snapshot.irkSize, sizeof(snapshot.irk))));
+            info.setMagicAccEncKey(QByteArray(reinterpret_cast<const char *>(snapshot.encKey),
+                                              qMin<int>(snapshot.encKeySize, sizeof(snapshot.encKey))));
+            info.endUpdate();
+            return true;
+        }
+        info.loadFromSettings(fallback);
+        return false;
+    }
+
+    // Flushes everything pending and stops the writer; safe to call twice
+    void shutdown()
+    {
+        if (!m_thread->isRunning())
+        {
+            return;
+        }
+        m_flushTimer.stop();
+        flush();
+        m_thread->quit(); // Processed after the posted batch
+        m_thread->wait();
+    }
+
+signals:
+    void batchReady(const QVariantHash &batch, const QByteArray &snapshot, const QString &snapshotPath);
+
+private slots:
+    void flush()
+    {
+        if (m_pending.isEmpty() && m_snapshot.isEmpty())
+        {
+            return;
+        }
+        emit batchReady(m_pending, m_snapshot, m_snapshotPath);
+        m_pending.clear();
+        m_snapshot.clear();
+    }
+
+private:
+    static constexpr int FLUSH_DELAY_MS = 500;
+    static constexpr quint32 SNAPSHOT_MAGIC = 0x424C5353; // 'BLSS'
+    static constexpr quint16 SNAPSHOT_VERSION = 2;
+
+    // Fixed layout so a restore is one read and a few memcpys
+    struct DeviceSnapshot
+    {
+        quint32 magic;
+        quint16 version;
+        quint16 size;
+        char address[18];
+        char deviceName[64];
+        qint32 model;
+        quint8 irk[16];
+        quint8 encKey[16];
+        quint8 irkSize;
+        quint8 encKeySize;
+        quint8 reserved[2];
+    };
+
+    static void copyString(char *dest, int capacity, const QString &value)
+    {
+        const QByteArray utf8 = value.toUtf8().left(capacity - 1);
+        std::memcpy(dest, utf8.constData(), utf8.size());
+        dest[utf8.size()] = '\0';
+    }
+
+    static void copyKey(quint8 *dest, quint8 &sizeOut, const QByteArray &key)
+    {
+        sizeOut = static_cast<quint8>(qMin<int>(key.size(), 16));
+        std::memcpy(dest, key.constData(), sizeOut);
+    }
+
+    QThread *m_thread = nullptr;
+    SettingsWriteWorker *m_worker = nullptr;
+    QTimer m_flushTimer;
+    QVariantHash m_pending;
+    QByteArray m_snapshot;
+    QString m_snapshotPath;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVarLengthArray>
+#include <cstring>
+#include <functional>
+
+// Parser stage for high-rate sensor streams (conversational awareness
+// levels, head-tracking orientation). Stream frames are recognized before
+// the general dispatcher, their fields extracted in place into a
+// preallocated per-stream batch, and each consumer is invoked once per
+// socket drain with every sample that arrived in it — instead of one
+// handler invocation (and its logging and metrics ceremony) per packet.
+// Samples are two 32-bit lanes, which covers every stream we decode; the
+// frame bytes themselves are never copied.
+class StreamStage
+{
+public:
+    struct Sample
+    {
+        qint32 a = 0;
+        qint32 b = 0;
+    };
+
+    // Extracts the sample from a frame already matched to the stream's
+    // header; returns false to drop malformed frames
+    using Extractor = std::function<bool(const QByteArray &frame, Sample &out)>;
+
+    // Receives the drain's worth of samples in arrival order
+    using BatchConsumer = std::function<void(const Sample *samples, int count)>;
+
+    // exactSize feeds the framer's length probe, mirroring the dispatcher's
+    // registered frame sizes; -1 for variable-length streams
+    void registerStream(const QByteArray &header, int exactSize, Extractor extract, BatchConsumer deliver)
+    {
+        m_streams.append({header, exactSize, std::move(extract), std::move(deliver), {}});
+    }
+
+    // Hot path: returns true when the frame belongs to a registered stream
+    // (whether or not it extracted cleanly), so the caller skips the
+    // general dispatcher
+    bool accept(const QByteArray &frame)
+    {
+        for (Stream &stream : m_streams)
+        {
+            if (!matches(stream, frame))
+            {
+                continue;
+            }
+            Sample sample;
+            if (stream.extract(frame, sample))
+            {
+                stream.pending.append(sample);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // Exact frame length for a stream header at the front of data, or -1;
+    // chained before the dispatcher's expectedSize in the length probe
+    int expectedSize(const QByteArray &data) const
+    {
+        for (const Stream &stream : m_streams)
+        {
+            if (stream.exactSize != -1 && matches(stream, data))
+            {
+                return stream.exactSize;
+            }
+        }
+        return -1;
+    }
+
+    // End of a socket drain: hand each stream's batch downstream in one call
+    void flush()
+    {
+        for (Stream &stream : m_streams)
+        {
+            if (stream.pending.isEmpty())
+            {
+                continue;
+            }
+            stream.deliver(stream.pending.constData(), stream.pending.size());
+            stream.pending.resize(0); // Keeps the preallocated capacity
+        }
+    }
+
+private:
+    struct Stream
+    {
+        QByteArray header;
+        int exactSize;
+        Extractor extract;
+        BatchConsumer deliver;
+        QVarLengthArray<Sample, 64> pending;
+    };
+
+    static bool matches(const Stream &stream, const QByteArray &frame)
+    {
+        return frame.size() >= stream.header.size() &&
+               std::memcmp(frame.constData(), stream.header.constData(), stream.header.size()) == 0;
+    }
+
+    QVarLengthArray<Stream, 4> m_streams;
+};
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QObject>
+#include <QStandardPaths>
+#include <QVariantList>
+#include <QVariantMap>
+#include <cstring>
+
+#include "battery.hpp"
+#include "eardetection.hpp"
+#include "logger.h"
+
+// Memory-mapped append-only log of battery and ear-detection events, so
+// drain-rate history and wear statistics survive across sessions. Records
+// are fixed 16-byte structs appended straight into the mapping — one
+// memcpy and a count bump on the packet path, no fsync, no text
+// serialization; the kernel writes pages back on its own schedule. The
+// file grows in chunks and opening maps it without reading it, so startup
+// cost is independent of how much history has accumulated. Appends are
+// crash-safe: the header's record count is bumped only after the record
+// bytes are in place, so a torn tail record is simply never seen.
+class TelemetryStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum RecordType
+    {
+        BatteryRecord = 0,
+        EarRecord = 1
+    };
+    Q_ENUM(RecordType)
+
+    static TelemetryStore &instance()
+    {
+        static TelemetryStore store;
+        return store;
+    }
+
+    // Battery snapshot at a batteryStatusChanged edge
+    void appendBattery(const Battery &battery)
+    {
+        Record record = {};
+        record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        record.type = BatteryRecord;
+        record.a = battery.getLeftPodLevel();
+        record.b = battery.getRightPodLevel();
+        record.c = battery.getCaseLevel();
+        record.flags = (battery.isLeftPodCharging() ? 0x01 : 0) |
+                       (battery.isRightPodCharging() ? 0x02 : 0) |
+                       (battery.isCaseCharging() ? 0x04 : 0) |
+                       (battery.isLeftPodAvailable() ? 0x08 : 0) |
+                       (battery.isRightPodAvailable() ? 0x10 : 0) |
+                       (battery.isCaseAvailable() ? 0x20 : 0);
+        append(record);
+    }
+
+    // Ear placement at a statusChanged edge
+    void appendEar(const EarDetection &earDetection)
+    {
+        Record record = {};
+        record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        record.type = EarRecord;
+        record.a = static_cast<quint8>(earDetection.getprimaryStatus());
+        record.b = static_cast<quint8>(earDetection.getsecondaryStatus());
+        append(record);
+    }
+
+    Q_INVOKABLE int recordCount() const
+    {
+        return m_map ? static_cast<int>(header()->recordCount) : 0;
+    }
+
+    // Newest-first history for the QML side; maxCount caps the walk so a
+    // year of log stays cheap to query
+    Q_INVOKABLE QVariantList history(int type, int maxCount) const
+    {
+        QVariantList out;
+        if (!m_map || maxCount <= 0)
+        {
+            return out;
+        }
+        const Record *records = firstRecord();
+        for (qint64 i = static_cast<qint64>(header()->recordCount) - 1; i >= 0 && out.size() < maxCount; i--)
+        {
+            const Record &record = records[i];
+            if (record.type != type)
+            {
+                continue;
+            }
+            QVariantMap entry;
+            entry.insert("timestamp", record.timestampMs);
+            if (record.type == BatteryRecord)
+            {
+                entry.insert("leftLevel", record.a);
+                entry.insert("rightLevel", record.b);
+                entry.insert("caseLevel", record.c);
+                entry.insert("leftCharging", bool(record.flags & 0x01));
+                entry.insert("rightCharging", bool(record.flags & 0x02));
+                entry.insert("caseCharging", bool(record.flags & 0x04));
+                entry.insert("leftAvailable", bool(record.flags & 0x08));
+                entry.insert("rightAvailable", bool(record.flags & 0x10));
+                entry.insert("caseAvailable", bool(record.flags & 0x20));
+            }
+            else
+            {
+                entry.insert("primaryStatus", record.a);
+                entry.insert("secondaryStatus", record.b);
+            }
+            out.append(entry);
+        }
+        return out;
+    }
+
+private:
+    // 16 bytes each so records never straddle a cache line boundary
+    struct FileHeader
+    {
+        quint32 magic;
+        quint16 version;
+        quint16 recordSize;
+        quint64 recordCount;
+    };
+
+    struct Record
+    {
+        qint64 timestampMs;
+        quint8 type;
+        quint8 a;
+        quint8 b;
+        quint8 c;
+        quint8 flags;
+        quint8 reserved[3];
+    };
+
+    static_assert(sizeof(FileHeader) == 16, "Telemetry header must stay 16 bytes");
+    static_assert(sizeof(Record) == 16, "Telemetry records must stay 16 bytes");
+
+    static constexpr quint32 MAGIC = 0x424C5431; // 'BLT1'
+    static constexpr quint16 VERSION = 1;
+    static constexpr qint64 GROW_RECORDS = 4096; // 64 KiB per growth step
+
+    TelemetryStore()
+    {
+        const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        QDir().mkpath(dir);
+        m_file.setFileName(dir + "/telemetry.bin");
+        if (!m_file.open(QIODevice::ReadWrite))
+        {
+            LOG_ERROR("Cannot open telemetry store: " << m_file.errorString());
+            return;
+        }
+
+        if (m_file.size() < static_cast<qint64>(sizeof(FileHeader)))
+        {
+            initializeFile();
+        }
+        remap(m_file.size());
+
+        if (m_map)
+        {
+            FileHeader *head = header();
+            if (head->magic != MAGIC || head->version != VERSION || head->recordSize != sizeof(Record))
+            {
+                LOG_WARN("Telemetry store has an unknown layout, starting fresh");
+                initializeFile();
+                remap(m_file.size());
+            }
+            else
+            {
+                // Clamp a count that outran a truncated file (e.g. full disk)
+                const quint64 capacity = (m_mapSize - sizeof(FileHeader)) / sizeof(Record);
+                head->recordCount = qMin(head->recordCount, capacity);
+            }
+        }
+    }
+
+    void initializeFile()
+    {
+        unmapFile();
+        m_file.resize(sizeof(FileHeader) + GROW_RECORDS * sizeof(Record));
+        FileHeader head = {MAGIC, VERSION, sizeof(Record), 0};
+        m_file.seek(0);
+        m_file.write(reinterpret_cast<const char *>(&head), sizeof(head));
+        m_file.flush();
+    }
+
+    void unmapFile()
+    {
+        if (m_map)
+        {
+            m_file.unmap(m_map);
+            m_map = nullptr;
+            m_mapSize = 0;
+        }
+    }
+
+    void remap(qint64 size)
+    {
+        unmapFile();
+        m_map = m_file.map(0, size);
+        m_mapSize = m_map ? size : 0;
+        if (!m_map)
+        {
+            LOG_ERROR("Cannot map telemetry store: " << m_file.errorString());
+        }
+    }
+
+    FileHeader *header() const { return reinterpret_cast<FileHeader *>(m_map); }
+    Record *firstRecord() const { return reinterpret_cast<Record *>(m_map + sizeof(FileHeader)); }
+
+    void append(const Record &record)
+    {
+        if (!m_map)
+        {
+            return;
+        }
+        const quint64 count = header()->recordCount;
+        const quint64 capacity = (m_mapSize - sizeof(FileHeader)) / sizeof(Record);
+        if (count == capacity)
+        {
+            // Rare slow path: grow the file one chunk and remap
+            unmapFile();
+            m_file.resize(sizeof(FileHeader) + (capacity + GROW_RECORDS) * sizeof(Record));
+            remap(m_file.size());
+            if (!m_map)
+            {
+                return;
+            }
+        }
+        std::memcpy(firstRecord() + count, &record, sizeof(Record));
+        // Publish the record only after its bytes are in place
+        header()->recordCount = count + 1;
+    }
+
+    QFile m_file;
+    uchar *m_map = nullptr;
+    qint64 m_mapSize = 0;
+};
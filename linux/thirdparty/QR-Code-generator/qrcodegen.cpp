@@ -327,8 +327,8 @@ QrCode::QrCode(int ver, Ecc ecl, const vector<uint8_t> &dataCodewords, int msk)
 		throw std::domain_error("Mask value out of range");
 	size = ver * 4 + 17;
 	size_t sz = static_cast<size_t>(size);
-	modules    = vector<vector<bool> >(sz, vector<bool>(sz));  // Initially all light
-	isFunction = vector<vector<bool> >(sz, vector<bool>(sz));
+	modules    = vector<uint8_t>(sz * sz, 0);  // Initially all light
+	isFunction = vector<uint8_t>(sz * sz, 0);
 	
 	// Compute ECC, draw modules
 	drawFunctionPatterns();
@@ -483,15 +483,19 @@ void QrCode::drawAlignmentPattern(int x, int y) {
 
 
 void QrCode::setFunctionModule(int x, int y, bool isDark) {
-	size_t ux = static_cast<size_t>(x);
-	size_t uy = static_cast<size_t>(y);
-	modules   .at(uy).at(ux) = isDark;
-	isFunction.at(uy).at(ux) = true;
+	size_t idx = static_cast<size_t>(y) * static_cast<size_t>(size) + static_cast<size_t>(x);
+	modules   .at(idx) = isDark ? 1 : 0;
+	isFunction.at(idx) = 1;
 }
 
 
 bool QrCode::module(int x, int y) const {
-	return modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
+	return modules.at(static_cast<size_t>(y) * static_cast<size_t>(size) + static_cast<size_t>(x)) != 0;
+}
+
+
+const uint8_t *QrCode::moduleRow(int y) const {
+	return &modules.at(static_cast<size_t>(y) * static_cast<size_t>(size));
 }
 
 
@@ -547,8 +551,9 @@ void QrCode::drawCodewords(const vector<uint8_t> &data) {
 				size_t x = static_cast<size_t>(right - j);  // Actual x coordinate
 				bool upward = ((right + 1) & 2) == 0;
 				size_t y = static_cast<size_t>(upward ? size - 1 - vert : vert);  // Actual y coordinate
-				if (!isFunction.at(y).at(x) && i < data.size() * 8) {
-					modules.at(y).at(x) = getBit(data.at(i >> 3), 7 - static_cast<int>(i & 7));
+				size_t idx = y * static_cast<size_t>(size) + x;
+				if (!isFunction.at(idx) && i < data.size() * 8) {
+					modules.at(idx) = getBit(data.at(i >> 3), 7 - static_cast<int>(i & 7)) ? 1 : 0;
 					i++;
 				}
 				// If this QR Code has any remainder bits (0 to 7), they were assigned as
@@ -565,6 +570,8 @@ void QrCode::applyMask(int msk) {
 		throw std::domain_error("Mask value out of range");
 	size_t sz = static_cast<size_t>(size);
 	for (size_t y = 0; y < sz; y++) {
+		uint8_t *modRow = &modules.at(y * sz);
+		const uint8_t *funcRow = &isFunction.at(y * sz);
 		for (size_t x = 0; x < sz; x++) {
 			bool invert;
 			switch (msk) {
@@ -578,7 +585,7 @@ void QrCode::applyMask(int msk) {
 				case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
 				default:  throw std::logic_error("Unreachable");
 			}
-			modules.at(y).at(x) = modules.at(y).at(x) ^ (invert & !isFunction.at(y).at(x));
+			modRow[x] = modRow[x] ^ static_cast<uint8_t>(invert && !funcRow[x]);
 		}
 	}
 }
@@ -586,14 +593,16 @@ void QrCode::applyMask(int msk) {
 
 long QrCode::getPenaltyScore() const {
 	long result = 0;
-	
+	size_t sz = static_cast<size_t>(size);
+
 	// Adjacent modules in row having same color, and finder-like patterns
 	for (int y = 0; y < size; y++) {
+		const uint8_t *row = &modules[static_cast<size_t>(y) * sz];
 		bool runColor = false;
 		int runX = 0;
 		std::array<int,7> runHistory = {};
 		for (int x = 0; x < size; x++) {
-			if (module(x, y) == runColor) {
+			if ((row[x] != 0) == runColor) {
 				runX++;
 				if (runX == 5)
 					result += PENALTY_N1;
@@ -603,7 +612,7 @@ long QrCode::getPenaltyScore() const {
 				finderPenaltyAddHistory(runX, runHistory);
 				if (!runColor)
 					result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-				runColor = module(x, y);
+				runColor = row[x] != 0;
 				runX = 1;
 			}
 		}
@@ -611,11 +620,13 @@ long QrCode::getPenaltyScore() const {
 	}
 	// Adjacent modules in column having same color, and finder-like patterns
 	for (int x = 0; x < size; x++) {
+		const uint8_t *col = &modules[static_cast<size_t>(x)];
 		bool runColor = false;
 		int runY = 0;
 		std::array<int,7> runHistory = {};
 		for (int y = 0; y < size; y++) {
-			if (module(x, y) == runColor) {
+			bool color = col[static_cast<size_t>(y) * sz] != 0;
+			if (color == runColor) {
 				runY++;
 				if (runY == 5)
 					result += PENALTY_N1;
@@ -625,31 +636,31 @@ long QrCode::getPenaltyScore() const {
 				finderPenaltyAddHistory(runY, runHistory);
 				if (!runColor)
 					result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-				runColor = module(x, y);
+				runColor = color;
 				runY = 1;
 			}
 		}
 		result += finderPenaltyTerminateAndCount(runColor, runY, runHistory) * PENALTY_N3;
 	}
-	
+
 	// 2*2 blocks of modules having same color
 	for (int y = 0; y < size - 1; y++) {
+		const uint8_t *row = &modules[static_cast<size_t>(y) * sz];
+		const uint8_t *rowBelow = row + sz;
 		for (int x = 0; x < size - 1; x++) {
-			bool  color = module(x, y);
-			if (  color == module(x + 1, y) &&
-			      color == module(x, y + 1) &&
-			      color == module(x + 1, y + 1))
+			uint8_t color = row[x];
+			if (  color == row[x + 1] &&
+			      color == rowBelow[x] &&
+			      color == rowBelow[x + 1])
 				result += PENALTY_N2;
 		}
 	}
-	
+
 	// Balance of dark and light modules
 	int dark = 0;
-	for (const vector<bool> &row : modules) {
-		for (bool color : row) {
-			if (color)
-				dark++;
-		}
+	for (uint8_t color : modules) {
+		if (color)
+			dark++;
 	}
 	int total = size * size;  // Note that size is odd, so dark/total != 1/2
 	// Compute the smallest integer k >= 0 such that (45-5k)% <= dark/total <= (55+5k)%
@@ -313,13 +313,15 @@ class QrCode final {
 	private: int mask;
 	
 	// Private grids of modules/pixels, with dimensions of size*size:
-	
-	// The modules of this QR Code (false = light, true = dark).
-	// Immutable after constructor finishes. Accessed through getModule().
-	private: std::vector<std::vector<bool> > modules;
-	
-	// Indicates function modules that are not subjected to masking. Discarded when constructor finishes.
-	private: std::vector<std::vector<bool> > isFunction;
+
+	// The modules of this QR Code (0 = light, nonzero = dark), stored as one
+	// contiguous row-major buffer of size*size cells. Immutable after
+	// constructor finishes. Accessed through getModule() or moduleRow().
+	private: std::vector<std::uint8_t> modules;
+
+	// Indicates function modules that are not subjected to masking, in the
+	// same flat row-major layout. Discarded when constructor finishes.
+	private: std::vector<std::uint8_t> isFunction;
 	
 	
 	
@@ -367,9 +369,17 @@ class QrCode final {
 	 * If the given coordinates are out of bounds, then false (light) is returned.
 	 */
 	public: bool getModule(int x, int y) const;
-	
-	
-	
+
+
+	/*
+	 * Returns a pointer to the given row of modules: size cells, one byte per
+	 * module, nonzero meaning dark. The pointer stays valid for the lifetime
+	 * of this object. The row index must be in the range [0, size).
+	 */
+	public: const std::uint8_t *moduleRow(int y) const;
+
+
+
 	/*---- Private helper methods for constructor: Drawing function modules ----*/
 	
 	// Reads this object's version field, and draws and marks all function modules.
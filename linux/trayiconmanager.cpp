@@ -1,4 +1,5 @@
 #include "trayiconmanager.h"
+#include "latencytracker.hpp"
 
 #include <QSystemTrayIcon>
 #include <QMenu>
@@ -34,10 +35,22 @@ void TrayIconManager::showNotification(const QString &title, const QString &mess
     trayIcon->showMessage(title, message, QSystemTrayIcon::Information, 3000);
 }
 
-void TrayIconManager::TrayIconManager::updateBatteryStatus(const QString &status)
+void TrayIconManager::updateBatteryStatus(int leftLevel, int rightLevel, int caseLevel)
 {
-    trayIcon->setToolTip("Battery Status: " + status);
-    updateIconFromBattery(status);
+    trayIcon->setToolTip(QString("Battery Status: Left: %1%, Right: %2%, Case: %3%")
+                             .arg(leftLevel)
+                             .arg(rightLevel)
+                             .arg(caseLevel));
+
+    const int minLevel = (leftLevel == 0) ? rightLevel : (rightLevel == 0) ? leftLevel
+                                                                           : qMin(leftLevel, rightLevel);
+    if (minLevel != m_lastMinLevel)
+    {
+        trayIcon->setIcon(batteryIcon(minLevel));
+        m_lastMinLevel = minLevel;
+    }
+    // Last stage of the synchronous packet-to-UI path; see latencytracker.hpp
+    LatencyTracker::instance().mark(LatencyTracker::UiUpdated);
 }
 
 void TrayIconManager::updateNoiseControlState(NoiseControlMode mode)
@@ -99,40 +112,47 @@ void TrayIconManager::setupMenuActions()
 
     trayMenu->addSeparator();
 
+    // On-demand dump of the packet-to-UI latency histograms
+    QAction *latencyAction = new QAction("Dump Latency Stats", trayMenu);
+    trayMenu->addAction(latencyAction);
+    connect(latencyAction, &QAction::triggered, this, [this](){emit latencyReportRequested();});
+
     // Quit action
     QAction *quitAction = new QAction("Quit", trayMenu);
     trayMenu->addAction(quitAction);
     connect(quitAction, &QAction::triggered, qApp, &QApplication::quit);
 }
 
-void TrayIconManager::updateIconFromBattery(const QString &status)
+// Returns the cached glyph for a battery level, rendering it on first
+// use. A palette change (light/dark switch) invalidates the whole cache,
+// so the glyphs always match the current theme.
+const QIcon &TrayIconManager::batteryIcon(int level)
 {
-    int leftLevel = 0;
-    int rightLevel = 0;
+    level = qBound(0, level, 100);
 
-    if (!status.isEmpty())
+    const QColor textColor = QApplication::palette().color(QPalette::WindowText);
+    if (textColor.rgba() != m_iconPaletteKey)
     {
-        // Parse the battery status string
-        QStringList parts = status.split(", ");
-        if (parts.size() >= 2)
+        for (QIcon &icon : m_iconCache)
         {
-            leftLevel = parts[0].split(": ")[1].replace("%", "").toInt();
-            rightLevel = parts[1].split(": ")[1].replace("%", "").toInt();
+            icon = QIcon();
         }
+        m_iconPaletteKey = textColor.rgba();
+    }
+
+    QIcon &icon = m_iconCache[level];
+    if (icon.isNull())
+    {
+        QPixmap pixmap(32, 32);
+        pixmap.fill(Qt::transparent);
+        QPainter painter(&pixmap);
+        painter.setPen(textColor);
+        painter.setFont(QFont("Arial", 12, QFont::Bold));
+        painter.drawText(pixmap.rect(), Qt::AlignCenter, QString::number(level) + "%");
+        painter.end();
+        icon = QIcon(pixmap);
     }
-    
-    int minLevel = (leftLevel == 0) ? rightLevel : (rightLevel == 0) ? leftLevel
-                                                                     : qMin(leftLevel, rightLevel);
-
-    QPixmap pixmap(32, 32);
-    pixmap.fill(Qt::transparent);
-    QPainter painter(&pixmap);
-    painter.setPen(QApplication::palette().color(QPalette::WindowText));
-    painter.setFont(QFont("Arial", 12, QFont::Bold));
-    painter.drawText(pixmap.rect(), Qt::AlignCenter, QString::number(minLevel) + "%");
-    painter.end();
-
-    trayIcon->setIcon(QIcon(pixmap));
+    return icon;
 }
 
 void TrayIconManager::onTrayIconActivated(QSystemTrayIcon::ActivationReason reason)
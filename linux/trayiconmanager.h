@@ -1,5 +1,7 @@
+#include <QIcon>
 #include <QObject>
 #include <QSystemTrayIcon>
+#include <array>
 
 #include "enums.h"
 
@@ -15,7 +17,7 @@ class TrayIconManager : public QObject
 public:
     explicit TrayIconManager(QObject *parent = nullptr);
 
-    void updateBatteryStatus(const QString &status);
+    void updateBatteryStatus(int leftLevel, int rightLevel, int caseLevel);
 
     void updateNoiseControlState(AirpodsTrayApp::Enums::NoiseControlMode);
 
@@ -37,6 +39,7 @@ public:
     {
         trayIcon->setIcon(QIcon(":/icons/assets/airpods.png"));
         trayIcon->setToolTip("");
+        m_lastMinLevel = -1;
     }
 
 signals:
@@ -52,9 +55,15 @@ private:
     QActionGroup *noiseControlGroup;
     bool m_notificationsEnabled = true;
 
+    // Percent glyphs rendered lazily, once per palette; an update is an
+    // array lookup plus setIcon
+    std::array<QIcon, 101> m_iconCache;
+    QRgb m_iconPaletteKey = 0;
+    int m_lastMinLevel = -1;
+
     void setupMenuActions();
 
-    void updateIconFromBattery(const QString &status);
+    const QIcon &batteryIcon(int level);
 
 signals:
     void trayClicked();
@@ -62,4 +71,5 @@ signals:
     void conversationalAwarenessToggled(bool enabled);
     void openApp();
     void openSettings();
+    void latencyReportRequested();
 };
\ No newline at end of file
@@ -1,31 +1,35 @@
 #include "ble/ble_backend.h"
 #include "ble/bluez_ble.h"
+#ifdef PLATFORM_BLUEZ
 #include <dbus/dbus.h>
+#endif
+#include <chrono>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <vector>
 
-static bool call_read_value(DBusConnection* conn, const std::string& char_path, std::vector<uint8_t>& out, std::string& err) {
+#ifdef PLATFORM_BLUEZ
+
+static DBusMessage* make_read_value_call(const std::string& char_path, std::string& err) {
   DBusMessage* msg = dbus_message_new_method_call("org.bluez", char_path.c_str(), "org.bluez.GattCharacteristic1", "ReadValue");
-  if (!msg) { err="dbus_message_new_method_call failed"; return false; }
+  if (!msg) { err="dbus_message_new_method_call failed"; return nullptr; }
   DBusMessageIter args, dict;
   dbus_message_iter_init_append(msg, &args);
   dbus_message_iter_open_container(&args, DBUS_TYPE_ARRAY, "{sv}", &dict); // empty options {}
   dbus_message_iter_close_container(&args, &dict);
+  return msg;
+}
 
-  DBusError dbus_err; dbus_error_init(&dbus_err);
-  DBusMessage* reply = dbus_connection_send_with_reply_and_block(conn, msg, 5000, &dbus_err);
-  dbus_message_unref(msg);
-  if (!reply) {
-    err = dbus_err.message ? dbus_err.message : "ReadValue call failed";
-    dbus_error_free(&dbus_err);
+static bool parse_read_value_reply(DBusMessage* reply, std::vector<uint8_t>& out, std::string& err) {
+  if (dbus_message_get_type(reply) == DBUS_MESSAGE_TYPE_ERROR) {
+    const char* name = dbus_message_get_error_name(reply);
+    err = name ? name : "ReadValue call failed";
     return false;
   }
-
   DBusMessageIter it;
   if (!dbus_message_iter_init(reply, &it) || dbus_message_iter_get_arg_type(&it) != DBUS_TYPE_ARRAY) {
     err = "Unexpected DBus reply";
-    dbus_message_unref(reply);
     return false;
   }
   DBusMessageIter arr;
@@ -35,41 +39,223 @@ static bool call_read_value(DBusConnection* conn, const std::string& char_path,
     out.push_back(b);
     dbus_message_iter_next(&arr);
   }
-  dbus_message_unref(reply);
   return true;
 }
 
+struct BleBackend::Impl {
+  DBusConnection* conn = nullptr;  // pooled for the lifetime of the process
+  size_t in_flight = 0;
+
+  // One heap-allocated context per in-flight read; freed by the notify path.
+  struct PendingRead {
+    Impl* impl;
+    std::string path;
+    BleReadCallback callback;
+  };
+
+  static void on_reply(DBusPendingCall* pending, void* user_data) {
+    PendingRead* read = static_cast<PendingRead*>(user_data);
+    BleReadResult result;
+    result.char_object_path = read->path;
+
+    DBusMessage* reply = dbus_pending_call_steal_reply(pending);
+    if (reply) {
+      std::vector<uint8_t> data;
+      if (parse_read_value_reply(reply, data, result.error)) result.value = std::move(data);
+      dbus_message_unref(reply);
+    } else {
+      result.error = "ReadValue reply lost";
+    }
+
+    read->impl->in_flight--;
+    if (read->callback) read->callback(result);
+  }
+
+  static void free_pending(void* user_data) {
+    delete static_cast<PendingRead*>(user_data);
+  }
+
+  bool ensure_connection(std::string& err) {
+    if (conn) return true;
+    DBusError dbus_err; dbus_error_init(&dbus_err);
+    conn = dbus_bus_get_private(DBUS_BUS_SYSTEM, &dbus_err);
+    if (!conn) {
+      err = dbus_err.message ? dbus_err.message : "DBus connect failed";
+      dbus_error_free(&dbus_err);
+      return false;
+    }
+    dbus_connection_set_exit_on_disconnect(conn, FALSE);
+    return true;
+  }
+
+  bool send_read(const std::string& char_path, BleReadCallback callback, std::string& err) {
+    if (!ensure_connection(err)) return false;
+
+    DBusMessage* msg = make_read_value_call(char_path, err);
+    if (!msg) return false;
+
+    DBusPendingCall* pending = nullptr;
+    if (!dbus_connection_send_with_reply(conn, msg, &pending, 5000) || !pending) {
+      dbus_message_unref(msg);
+      err = "dbus_connection_send_with_reply failed";
+      return false;
+    }
+    dbus_message_unref(msg);
+
+    PendingRead* read = new PendingRead{this, char_path, std::move(callback)};
+    if (!dbus_pending_call_set_notify(pending, on_reply, read, free_pending)) {
+      dbus_pending_call_cancel(pending);
+      dbus_pending_call_unref(pending);
+      delete read;
+      err = "dbus_pending_call_set_notify failed";
+      return false;
+    }
+    dbus_pending_call_unref(pending);  // notify holds its own reference
+    in_flight++;
+    return true;
+  }
+
+  int pump(int timeout_ms) {
+    if (!conn || in_flight == 0) return 0;
+    size_t before = in_flight;
+    dbus_connection_read_write_dispatch(conn, timeout_ms);
+    // Dispatch everything already queued without blocking again
+    while (dbus_connection_dispatch(conn) == DBUS_DISPATCH_DATA_REMAINS) {}
+    return static_cast<int>(before - in_flight);
+  }
+};
+
+BleBackend::BleBackend() : impl_(new Impl) {}
+BleBackend::~BleBackend() {
+  if (impl_->conn) {
+    dbus_connection_close(impl_->conn);
+    dbus_connection_unref(impl_->conn);
+  }
+  delete impl_;
+}
+
+BleBackend& BleBackend::instance() {
+  static BleBackend backend;
+  return backend;
+}
+
+bool BleBackend::read_characteristic_async(const std::string& char_object_path,
+                                           BleReadCallback callback,
+                                           std::string* error_out) {
+  std::string err;
+  if (!impl_->send_read(char_object_path, std::move(callback), err)) {
+    if (error_out) *error_out = err;
+    return false;
+  }
+  return true;
+}
+
+int BleBackend::poll(int timeout_ms) {
+  return impl_->pump(timeout_ms);
+}
+
+std::vector<BleReadResult>
+BleBackend::read_characteristics(const std::vector<std::string>& char_object_paths,
+                                 int timeout_ms) {
+  // Completion state lives on the heap, owned jointly by the callbacks: the
+  // bus library keeps its own timeout for each pending call, so a reply can
+  // arrive after we give up and return. A late callback dispatched by a
+  // later pump then writes into this block instead of through dangling
+  // stack references.
+  struct BatchState {
+    std::vector<BleReadResult> results;
+    size_t completed = 0;
+  };
+  auto state = std::make_shared<BatchState>();
+  state->results.resize(char_object_paths.size());
+
+  // Issue every read first so they overlap on the bus, then collect
+  for (size_t i = 0; i < char_object_paths.size(); ++i) {
+    state->results[i].char_object_path = char_object_paths[i];
+    std::string err;
+    bool sent = impl_->send_read(char_object_paths[i],
+                                 [state, i](const BleReadResult& r) {
+                                   state->results[i] = r;
+                                   state->completed++;
+                                 },
+                                 err);
+    if (!sent) {
+      state->results[i].error = err;
+      state->completed++;
+    }
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (state->completed < char_object_paths.size()) {
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+    if (remaining <= 0) break;
+    impl_->pump(static_cast<int>(remaining));
+  }
+
+  std::vector<BleReadResult> results = state->results;
+  for (auto& r : results) {
+    if (!r.value && r.error.empty()) r.error = "ReadValue timed out";
+  }
+  return results;
+}
+
 std::optional<std::vector<uint8_t>>
 bluez_read_characteristic(const std::string& char_object_path,
                           std::string* error_out) {
-#ifdef PLATFORM_BLUEZ
-  DBusError err; dbus_error_init(&err);
-  DBusConnection* conn = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
-  if (!conn) {
-    if (error_out) *error_out = err.message ? err.message : "DBus connect failed";
-    dbus_error_free(&err);
+  auto results = BleBackend::instance().read_characteristics({char_object_path});
+  if (results.empty() || !results[0].value) {
+    if (error_out && !results.empty()) *error_out = results[0].error;
     return std::nullopt;
   }
-  std::vector<uint8_t> data; std::string e;
-  bool ok = call_read_value(conn, char_object_path, data, e);
-  if (!ok) { if (error_out) *error_out = e; return std::nullopt; }
-  return data;
-#else
-  (void)char_object_path; (void)error_out;
+  return results[0].value;
+}
+
+#else  // !PLATFORM_BLUEZ
+
+struct BleBackend::Impl {};
+
+BleBackend::BleBackend() : impl_(new Impl) {}
+BleBackend::~BleBackend() { delete impl_; }
+
+BleBackend& BleBackend::instance() {
+  static BleBackend backend;
+  return backend;
+}
+
+bool BleBackend::read_characteristic_async(const std::string&, BleReadCallback,
+                                           std::string* error_out) {
+  if (error_out) *error_out = "BLE backend unavailable on this platform";
+  return false;
+}
+
+int BleBackend::poll(int) { return 0; }
+
+std::vector<BleReadResult>
+BleBackend::read_characteristics(const std::vector<std::string>& char_object_paths, int) {
+  std::vector<BleReadResult> results(char_object_paths.size());
+  for (size_t i = 0; i < char_object_paths.size(); ++i) {
+    results[i].char_object_path = char_object_paths[i];
+    results[i].error = "BLE backend unavailable on this platform";
+  }
+  return results;
+}
+
+std::optional<std::vector<uint8_t>>
+bluez_read_characteristic(const std::string& char_object_path,
+                          std::string* error_out) {
+  (void)char_object_path;
+  if (error_out) *error_out = "BLE backend unavailable on this platform";
   return std::nullopt;
-#endif
 }
 
+#endif  // PLATFORM_BLUEZ
+
 std::optional<std::vector<uint8_t>>
 ble_read_characteristic(const std::string& device_id_or_path,
                         const std::string& service_uuid,
                         const std::string& characteristic_uuid,
                         std::string* error_out) {
   (void)service_uuid; (void)characteristic_uuid;
-#ifdef PLATFORM_BLUEZ
   return bluez_read_characteristic(device_id_or_path, error_out);
-#else
-  (void)device_id_or_path; (void)error_out;
-  return std::nullopt;
-#endif
-}
\ No newline at end of file
+}